@@ -0,0 +1,216 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// =====================
+// 작은 microbenchmark harness (Google Benchmark 스타일)
+// - BENCH 함수는 setup 후 while (st.keep_running()) { ... } 로 측정 구간 지정
+// - iteration 수는 min_time을 넘을 때까지 자동 증가, repetition 중 최솟값 보고
+// - allocs/op: bench 실행 파일이 operator new를 바꿔 g_bench_allocs를 증가시킴
+// - JSON baseline 저장(--save) / 비교(--compare, threshold 초과 시 exit 1)
+// =====================
+
+inline std::atomic<std::uint64_t> g_bench_allocs{0};
+
+template <class T>
+inline void bench_do_not_optimize(T const& v) {
+    asm volatile("" : : "r,m"(v) : "memory");
+}
+
+inline void bench_clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+class BenchState {
+public:
+    explicit BenchState(std::uint64_t iters) : iters_(iters) {}
+
+    // 첫 호출에서 타이머 시작, iters번째 이후 호출에서 정지
+    bool keep_running() {
+        if (done_ == 0 && !started_) {
+            started_ = true;
+            allocs0_ = g_bench_allocs.load(std::memory_order_relaxed);
+            t0_ = clock::now();
+        }
+        if (done_ < iters_) { ++done_; return true; }
+        t1_ = clock::now();
+        allocs1_ = g_bench_allocs.load(std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint64_t iterations() const { return iters_; }
+    double elapsed_ns() const { return std::chrono::duration<double, std::nano>(t1_ - t0_).count(); }
+    std::uint64_t allocs() const { return allocs1_ - allocs0_; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::uint64_t iters_ = 0;
+    std::uint64_t done_ = 0;
+    bool started_ = false;
+    clock::time_point t0_{}, t1_{};
+    std::uint64_t allocs0_ = 0, allocs1_ = 0;
+};
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t iterations = 0;
+    double ns_per_op = 0.0;
+    double allocs_per_op = 0.0;
+};
+
+struct BenchOptions {
+    double min_time_s = 0.2;
+    int repetitions = 3;
+    std::string filter;          // 이름에 포함되면 실행 (빈 문자열 = 전부)
+    std::string save_path;
+    std::string compare_path;
+    double threshold = 0.10;     // ns/op 10% 초과 증가 = regression
+};
+
+class BenchRunner {
+public:
+    using Fn = std::function<void(BenchState&)>;
+
+    void add(const std::string& name, Fn fn) { benches_.push_back({name, std::move(fn)}); }
+
+    std::vector<BenchResult> run(const BenchOptions& opt, std::ostream& os) const {
+        std::vector<BenchResult> results;
+        os << std::left << std::setw(36) << "benchmark" << std::right
+           << std::setw(14) << "iterations" << std::setw(14) << "ns/op"
+           << std::setw(14) << "allocs/op" << "\n";
+        os << std::string(78, '-') << "\n";
+
+        for (const auto& b : benches_) {
+            if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos) continue;
+
+            BenchResult best;
+            best.name = b.name;
+            best.ns_per_op = 1e300;
+            for (int r = 0; r < std::max(1, opt.repetitions); ++r) {
+                const BenchResult res = run_one_(b, opt.min_time_s);
+                if (res.ns_per_op < best.ns_per_op) best = res;
+            }
+
+            os << std::left << std::setw(36) << best.name << std::right
+               << std::setw(14) << best.iterations
+               << std::setw(14) << std::fixed << std::setprecision(2) << best.ns_per_op
+               << std::setw(14) << std::setprecision(3) << best.allocs_per_op << "\n";
+            os.unsetf(std::ios::floatfield);
+            results.push_back(best);
+        }
+        return results;
+    }
+
+private:
+    struct Entry { std::string name; Fn fn; };
+
+    static BenchResult run_one_(const Entry& b, double min_time_s) {
+        std::uint64_t iters = 1;
+        for (;;) {
+            BenchState st(iters);
+            b.fn(st);
+            const double ns = st.elapsed_ns();
+            if (ns >= min_time_s * 1e9 || iters >= 1000000000ull) {
+                BenchResult r;
+                r.name = b.name;
+                r.iterations = iters;
+                r.ns_per_op = ns / iters;
+                r.allocs_per_op = static_cast<double>(st.allocs()) / iters;
+                return r;
+            }
+            // 측정값으로 목표 시간에 필요한 횟수 예측 (최대 10배씩)
+            const double want = (ns > 0.0) ? min_time_s * 1e9 / ns * iters * 1.4 : iters * 10.0;
+            iters = static_cast<std::uint64_t>(std::min(std::max(want, iters + 1.0), iters * 10.0));
+        }
+    }
+
+    std::vector<Entry> benches_;
+};
+
+// ---------- JSON baseline ----------
+// 한 줄에 benchmark 하나: 비교 시 단순 파싱
+
+inline bool bench_save_json(const std::string& path, const std::vector<BenchResult>& rs) {
+    std::ofstream f(path);
+    if (!f) return false;
+    f << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < rs.size(); ++i) {
+        f << "    {\"name\": \"" << rs[i].name << "\", \"iterations\": " << rs[i].iterations
+          << ", \"ns_per_op\": " << std::setprecision(6) << rs[i].ns_per_op
+          << ", \"allocs_per_op\": " << rs[i].allocs_per_op << "}"
+          << (i + 1 < rs.size() ? "," : "") << "\n";
+    }
+    f << "  ]\n}\n";
+    return static_cast<bool>(f);
+}
+
+inline bool bench_json_number_(const std::string& line, const std::string& key, double& v) {
+    const std::string k = "\"" + key + "\": ";
+    const auto p = line.find(k);
+    if (p == std::string::npos) return false;
+    v = std::strtod(line.c_str() + p + k.size(), nullptr);
+    return true;
+}
+
+inline bool bench_load_json(const std::string& path, std::map<std::string, BenchResult>& out) {
+    std::ifstream f(path);
+    if (!f) return false;
+    std::string line;
+    while (std::getline(f, line)) {
+        const std::string nk = "\"name\": \"";
+        const auto p = line.find(nk);
+        if (p == std::string::npos) continue;
+        const auto q = line.find('"', p + nk.size());
+        if (q == std::string::npos) continue;
+
+        BenchResult r;
+        r.name = line.substr(p + nk.size(), q - p - nk.size());
+        double it = 0.0;
+        bench_json_number_(line, "iterations", it);
+        r.iterations = static_cast<std::uint64_t>(it);
+        if (!bench_json_number_(line, "ns_per_op", r.ns_per_op)) continue;
+        bench_json_number_(line, "allocs_per_op", r.allocs_per_op);
+        out[r.name] = r;
+    }
+    return true;
+}
+
+// regression 수 반환: ns/op가 threshold 넘게 늘었거나 allocs/op가 늘었으면 regression
+inline int bench_compare(const std::map<std::string, BenchResult>& base,
+                         const std::vector<BenchResult>& cur, double threshold, std::ostream& os) {
+    int regressions = 0;
+    os << "\n[COMPARE] threshold=" << threshold * 100.0 << " %\n";
+    for (const auto& r : cur) {
+        const auto it = base.find(r.name);
+        if (it == base.end()) {
+            os << "  " << r.name << ": (new)\n";
+            continue;
+        }
+        const double delta = (it->second.ns_per_op > 0.0)
+                           ? (r.ns_per_op - it->second.ns_per_op) / it->second.ns_per_op : 0.0;
+        const bool slow = delta > threshold;
+        const bool more_allocs = r.allocs_per_op > it->second.allocs_per_op + 1e-3;
+        if (slow || more_allocs) ++regressions;
+
+        std::ostringstream d;
+        d << std::showpos << std::fixed << std::setprecision(1) << delta * 100.0 << " %";
+        os << "  " << r.name << ": " << it->second.ns_per_op << " -> " << r.ns_per_op
+           << " ns/op (" << d.str() << ")";
+        if (more_allocs) os << " allocs " << it->second.allocs_per_op << " -> " << r.allocs_per_op;
+        os << ((slow || more_allocs) ? "  REGRESSION" : "") << "\n";
+    }
+    os << "regressions: " << regressions << "\n";
+    return regressions;
+}
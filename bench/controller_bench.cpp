@@ -0,0 +1,337 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../src/controller_core.hpp"
+#include "../src/logger.hpp"
+#include "../src/drivers/fakecan_bus.hpp"
+#include "../src/drivers/fakecan_codec.hpp"
+#include "../sim/plant.hpp"
+#include "../sim/plant_batch.hpp"
+#include "../sim/vehicle_plant.hpp"
+#include "bench_harness.hpp"
+
+// =====================
+// controller_bench: hot path microbenchmark (ns/op, allocs/op)
+//
+// 사용:
+//   controller_bench [--filter STR] [--min-time S] [--reps N]
+//                    [--save base.json] [--compare base.json] [--threshold PCT]
+// =====================
+
+// ---------- allocation counter ----------
+void* operator new(std::size_t n) {
+    g_bench_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static constexpr double DT_S = 0.01;
+
+// ---------- ControllerCore::step (State별) ----------
+
+static Inputs base_inputs() {
+    Inputs in{};
+    in.comms_ok = true;
+    in.battery_ok = true;
+    in.no_active_fault = true;
+    in.velocity = 0.0;
+    in.target_velocity = 1.0;
+    return in;
+}
+
+static void add_step_bench(BenchRunner& br, State want, Inputs in) {
+    br.add(std::string("core_step/") + state_name(want), [want, in](BenchState& st) {
+        ControllerCore core;
+        Inputs x = in;
+        for (int i = 0; i < 20; ++i) core.step(x, DT_S);   // 원하는 state로 진입
+        if (static_cast<State>(core.debug().state) != want) {
+            std::cerr << "core_step: expected " << state_name(want) << ", got "
+                      << state_name(static_cast<State>(core.debug().state)) << "\n";
+            std::exit(2);
+        }
+        while (st.keep_running()) {
+            Outputs out = core.step(x, DT_S);
+            bench_do_not_optimize(out);
+        }
+    });
+}
+
+static void register_core(BenchRunner& br) {
+    add_step_bench(br, State::IDLE, base_inputs());
+
+    Inputs drive = base_inputs();
+    drive.drive_enable = true;
+    drive.velocity = 0.4;
+    add_step_bench(br, State::DRIVE, drive);
+
+    Inputs lift = base_inputs();
+    lift.lift_request = true;
+    add_step_bench(br, State::LIFT_OP, lift);
+
+    Inputs dump = base_inputs();
+    dump.dump_request = true;
+    add_step_bench(br, State::DUMP_OP, dump);
+
+    Inputs fault = base_inputs();
+    fault.critical_dtc = true;
+    fault.no_active_fault = false;
+    add_step_bench(br, State::FAULT, fault);
+
+    Inputs estop = base_inputs();
+    estop.estop_button = true;
+    add_step_bench(br, State::E_STOP, estop);
+}
+
+// ---------- PID::compute ----------
+
+static void register_pid(BenchRunner& br) {
+    br.add("pid_compute", [](BenchState& st) {
+        PID pid(ControllerCore::DRIVE_KP, ControllerCore::DRIVE_KI, ControllerCore::DRIVE_KD);
+        double v = 0.0;
+        while (st.keep_running()) {
+            const double u = pid.compute(1.0, v, DT_S);
+            v += 0.01 * (u - v);   // 입력이 매번 바뀌도록 (상수 전파 방지)
+            bench_do_not_optimize(u);
+        }
+    });
+}
+
+// ---------- codec ----------
+
+static void register_codec(BenchRunner& br) {
+    br.add("codec/encode_cmd", [](BenchState& st) {
+        Inputs in = base_inputs();
+        in.drive_enable = true;
+        while (st.keep_running()) {
+            bench_do_not_optimize(in);
+            CanFrame f = encode_cmd(in);
+            bench_do_not_optimize(f);
+        }
+    });
+
+    br.add("codec/decode_cmd", [](BenchState& st) {
+        Inputs src = base_inputs();
+        src.target_velocity = 0.75;
+        src.drive_enable = true;
+        const CanFrame f = encode_cmd(src);
+        Inputs in{};
+        while (st.keep_running()) {
+            bench_do_not_optimize(f);
+            decode_cmd(f, in);
+            bench_do_not_optimize(in);
+        }
+    });
+
+    br.add("codec/encode_act", [](BenchState& st) {
+        Outputs out{};
+        out.drive_cmd = true;
+        out.motor_cmd = 0.42;
+        while (st.keep_running()) {
+            bench_do_not_optimize(out);
+            CanFrame f = encode_act(out);
+            bench_do_not_optimize(f);
+        }
+    });
+
+    br.add("codec/encode_diag", [](BenchState& st) {
+        Outputs out{};
+        out.fault_code = 20;
+        out.lift_cmd = true;
+        while (st.keep_running()) {
+            bench_do_not_optimize(out);
+            CanFrame f = encode_diag(out);
+            bench_do_not_optimize(f);
+        }
+    });
+}
+
+// ---------- FakeCanBus: pending 깊이별 push_rx + poll + pop_rx ----------
+// 프레임 간격 10us, 지연 depth*10us -> 정상상태에서 pending에 depth개 유지
+
+static void register_bus(BenchRunner& br) {
+    for (uint64_t depth : {1ull, 16ull, 256ull, 4096ull}) {
+        br.add("bus/push_rx+poll/depth:" + std::to_string(depth), [depth](BenchState& st) {
+            using DeepBus = BasicFakeCanBus<256, 256, 8192>;
+            DeepBus::Config cfg;
+            cfg.delay_us = depth * 10;
+            auto owner = std::make_unique<DeepBus>(cfg);   // ~400KB, stack 대신 heap (setup)
+            DeepBus& bus = *owner;
+            CanFrame f;
+            f.id = 0x100;
+            f.dlc = 4;
+
+            uint64_t t = 0;
+            for (uint64_t i = 0; i < depth * 2; ++i) {   // 깊이 채우기
+                t += 10;
+                bus.poll(t);
+                bus.push_rx(f);
+                while (bus.pop_rx()) {}
+            }
+
+            while (st.keep_running()) {
+                t += 10;
+                bus.poll(t);
+                f.t_us = t;
+                bus.push_rx(f);
+                auto rx = bus.pop_rx();
+                bench_do_not_optimize(rx);
+            }
+        });
+    }
+}
+
+// ---------- FakeCanBus: tick당 burst 수신 (push N -> poll -> drain_rx 한 번) ----------
+
+static void register_bus_burst(BenchRunner& br) {
+    for (size_t burst : {size_t{1}, size_t{8}, size_t{64}}) {
+        br.add("bus/drain_rx/burst:" + std::to_string(burst), [burst](BenchState& st) {
+            FakeCanBus bus;
+            CanFrame f;
+            f.id = 0x100;
+            f.dlc = 4;
+            CanFrame rx_buf[256];
+            uint64_t t = 0;
+            while (st.keep_running()) {
+                for (size_t i = 0; i < burst; ++i) bus.push_rx(f);
+                bus.poll(t += 10000);
+                const size_t n = bus.drain_rx(rx_buf);
+                bench_do_not_optimize(n);
+                bench_do_not_optimize(rx_buf[0]);
+            }
+        });
+    }
+}
+
+// ---------- Plant::step ----------
+
+static void register_plant(BenchRunner& br) {
+    br.add("plant_step", [](BenchState& st) {
+        Plant plant;
+        Inputs in = base_inputs();
+        Outputs out{};
+        out.motor_cmd = 0.3;
+        while (st.keep_running()) {
+            plant.step(out, in, DT_S);
+            bench_do_not_optimize(in.velocity);
+        }
+    });
+
+    // VehiclePlant: 기본(RK4 x2 substep), RK4 x4 / Euler x1, control tick 1번 = step 1번
+    auto vehicle = [](PlantIntegrator integ, int substeps) {
+        return [integ, substeps](BenchState& st) {
+            VehiclePlantParams p;
+            p.integrator = integ;
+            p.substeps = substeps;
+            p.slope_rad = 0.02;
+            VehiclePlant plant(p);
+            Inputs in = base_inputs();
+            Outputs out{};
+            out.motor_cmd = 0.3;
+            out.lift_cmd = true;
+            while (st.keep_running()) {
+                plant.step(out, in, DT_S);
+                bench_do_not_optimize(in.velocity);
+            }
+        };
+    };
+    br.add("vehicle_plant_rk4x2", vehicle(PlantIntegrator::RK4, 2));   // 기본값
+    br.add("vehicle_plant_rk4x4", vehicle(PlantIntegrator::RK4, 4));
+    br.add("vehicle_plant_euler", vehicle(PlantIntegrator::Euler, 1));
+
+    // PlantBatch: 1024대 1 tick (ISA별, lane당 시간 = 결과 / 1024)
+    auto batch = [](PlantBatch::Isa isa) {
+        return [isa](BenchState& st) {
+            PlantBatch plants(1024);
+            plants.set_isa(isa);
+            std::vector<double> cmd(plants.size(), 0.3);
+            while (st.keep_running()) {
+                plants.step(cmd.data(), DT_S);
+                bench_do_not_optimize(plants.vel[0]);
+            }
+        };
+    };
+    br.add("plant_batch_1024_scalar", batch(PlantBatch::Isa::Scalar));
+    br.add("plant_batch_1024_avx2", batch(PlantBatch::Isa::AVX2));
+}
+
+// ---------- CSVLogger::log (/dev/null, 포맷 비용) ----------
+
+static void register_logger(BenchRunner& br) {
+    br.add("csv_logger_log", [](BenchState& st) {
+        CSVLogger log("/dev/null");
+        const std::string state = "DRIVE";
+        const std::string reason = "NONE";
+        int tick = 0;
+        while (st.keep_running()) {
+            log.log(tick++, DT_S, state,
+                    1, 0, 0, 0,
+                    1, 1,
+                    0, reason, 0,
+                    1, 0, 0,
+                    1.0, 0.512345, 0.301234,
+                    0.123456, 0.4, 0.4, 0,
+                    0.0, 0.0);
+        }
+    });
+}
+
+// ---------- main ----------
+
+static bool parse_args(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--filter" && i + 1 < argc)          opt.filter = argv[++i];
+        else if (a == "--min-time" && i + 1 < argc)   opt.min_time_s = std::atof(argv[++i]);
+        else if (a == "--reps" && i + 1 < argc)       opt.repetitions = std::atoi(argv[++i]);
+        else if (a == "--save" && i + 1 < argc)       opt.save_path = argv[++i];
+        else if (a == "--compare" && i + 1 < argc)    opt.compare_path = argv[++i];
+        else if (a == "--threshold" && i + 1 < argc)  opt.threshold = std::atof(argv[++i]) / 100.0;
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!parse_args(argc, argv, opt)) {
+        std::cerr << "usage: controller_bench [--filter STR] [--min-time S] [--reps N]\n"
+                     "                        [--save FILE] [--compare FILE] [--threshold PCT]\n";
+        return 2;
+    }
+
+    BenchRunner br;
+    register_core(br);
+    register_pid(br);
+    register_codec(br);
+    register_bus(br);
+    register_bus_burst(br);
+    register_plant(br);
+    register_logger(br);
+
+    const auto results = br.run(opt, std::cout);
+
+    if (!opt.save_path.empty()) {
+        if (!bench_save_json(opt.save_path, results)) {
+            std::cerr << "cannot write " << opt.save_path << "\n";
+            return 2;
+        }
+        std::cout << "baseline saved: " << opt.save_path << "\n";
+    }
+
+    if (!opt.compare_path.empty()) {
+        std::map<std::string, BenchResult> base;
+        if (!bench_load_json(opt.compare_path, base)) {
+            std::cerr << "cannot read " << opt.compare_path << "\n";
+            return 2;
+        }
+        return bench_compare(base, results, opt.threshold, std::cout) ? 1 : 0;
+    }
+    return 0;
+}
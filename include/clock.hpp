@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// =====================
+// runtime loop / FakeCanBus::poll / comms timeout이 공유하는 시간원
+// - SteadyClock : 실제 시간 (sleep은 진짜로 잠)
+// - VirtualClock: 가상 시간 (sleep_until이 즉시 시간만 점프 -> CPU 속도로 진행)
+// =====================
+class IClock {
+public:
+    virtual ~IClock() = default;
+    virtual std::uint64_t now_us() const = 0;
+    virtual void sleep_until_us(std::uint64_t t_us) = 0;
+};
+
+class SteadyClock final : public IClock {
+public:
+    std::uint64_t now_us() const override {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void sleep_until_us(std::uint64_t t_us) override {
+        using namespace std::chrono;
+        std::this_thread::sleep_until(steady_clock::time_point(microseconds(t_us)));
+    }
+};
+
+class VirtualClock final : public IClock {
+public:
+    explicit VirtualClock(std::uint64_t start_us = 0) : t_us_(start_us) {}
+
+    std::uint64_t now_us() const override { return t_us_; }
+
+    void sleep_until_us(std::uint64_t t_us) override {
+        if (t_us > t_us_) t_us_ = t_us;
+    }
+
+    void advance_us(std::uint64_t dt_us) { t_us_ += dt_us; }
+
+private:
+    std::uint64_t t_us_ = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include "../main_inputs_outputs.hpp"
+#include "../packed_io.hpp"
 
 // Inputs + 메타(시간/유효성) 묶음
 struct InputFrame {
@@ -9,6 +10,17 @@ struct InputFrame {
     bool valid = true;
 };
 
+// ring / 스레드 경계용 (72B -> 48B, 한 cache line 안)
+struct PackedInputFrame {
+    PackedInputs in{};
+    std::uint64_t t_us = 0;
+    bool valid = true;
+
+    static PackedInputFrame pack(const InputFrame& f) { return PackedInputFrame{PackedInputs::pack(f.in), f.t_us, f.valid}; }
+    InputFrame unpack() const { return InputFrame{in.unpack(), t_us, valid}; }
+};
+static_assert(sizeof(PackedInputFrame) <= 64, "PackedInputFrame must fit in a cache line");
+
 class IInputSource {
 public:
     virtual ~IInputSource() = default;
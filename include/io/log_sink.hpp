@@ -0,0 +1,248 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+
+#include "output_sink.hpp"
+#include "../util/spsc_ring.hpp"
+#include "../util/static_ring.hpp"
+#include "../../src/controller_core.hpp"
+
+// =====================
+// LogSink: 비동기 + 간축(decimation) + fault trigger 로그 (console 등 ostream)
+// - control thread: write()에서 OutputFrame + ControllerDebug + Inputs 일부를 LogRecord(64B)로
+//   pack해서 SPSC ring에 복사만 함 (포맷/IO/할당 없음, 가득 차면 drop 카운트)
+// - writer thread: LogTrigger로 남길 레코드를 고르고 포맷/출력
+//   평상시 decimate_period_us마다 1줄 (기본 1Hz)
+//   fault latch(또는 latch 중 fault_code 변경) 시 앞 pre_trigger_us 히스토리 + 뒤
+//   post_trigger_us 동안 전 레코드 (기본 ±2s)
+// =====================
+
+// 로그에 남기는 ControllerDebug 부분 (format_log_line / LogTrigger가 쓰는 것만)
+struct LogDebug {
+    enum Flag : std::uint8_t { FaultLatched = 1u << 0, CommsOkFiltered = 1u << 1, WouldWorsen = 1u << 2 };
+
+    double integ = 0.0;
+    std::uint16_t fault_code = 0;
+    std::uint8_t state = 0;
+    std::uint8_t flags = CommsOkFiltered;
+
+    bool fault_latched() const { return flags & FaultLatched; }
+    bool comms_ok_filtered() const { return flags & CommsOkFiltered; }
+    bool would_worsen() const { return flags & WouldWorsen; }
+    void set(Flag f, bool v) { flags = static_cast<std::uint8_t>(v ? (flags | f) : (flags & ~f)); }
+
+    static LogDebug pack(const ControllerDebug& d) {
+        LogDebug r;
+        r.integ = d.pid_dbg.integ;
+        r.fault_code = d.fault_code;
+        r.state = static_cast<std::uint8_t>(d.state);
+        r.set(FaultLatched, d.fault_latched);
+        r.set(CommsOkFiltered, d.comms_ok_filtered);
+        r.set(WouldWorsen, d.pid_dbg.would_worsen);
+        return r;
+    }
+};
+
+// tick당 1개 (ring/히스토리 원소, 한 cache line 이하)
+struct LogRecord {
+    std::uint64_t t_us = 0;
+    PackedOutputs out{};
+    LogDebug dbg{};
+    double velocity = 0.0;
+    double target_velocity = 0.0;
+    bool drive_enable = false;
+    bool comms_ok = true;
+    std::uint32_t heartbeat = 0;   // diag task liveness (set_heartbeat 안 했으면 0)
+};
+static_assert(std::is_trivially_copyable<LogRecord>::value, "LogRecord must be POD");
+static_assert(sizeof(LogRecord) <= 64, "LogRecord must fit in a cache line");
+
+enum class LogEmit : std::uint8_t { Decimated, PreTrigger, Trigger, PostTrigger };
+
+// 남길 레코드 선택 (단일 스레드, 시간순 feed)
+// HistoryN: pre-trigger 히스토리 용량 (주기 x pre_trigger_us 이상)
+template <std::size_t HistoryN>
+class LogTrigger {
+public:
+    struct Config {
+        std::uint64_t decimate_period_us = 1000000;   // 0 = 간축 없이 전부
+        std::uint64_t pre_trigger_us = 2000000;
+        std::uint64_t post_trigger_us = 2000000;
+    };
+
+    LogTrigger() : LogTrigger(Config{}) {}
+    explicit LogTrigger(Config cfg) : cfg_(cfg), history_(OverflowPolicy::DropOldest) {}
+
+    // emit(const LogRecord&, LogEmit) 를 시간순으로 호출
+    template <class EmitFn>
+    void feed(const LogRecord& r, EmitFn&& emit) {
+        const bool edge = r.dbg.fault_latched() &&
+                          (!prev_latched_ || r.dbg.fault_code != prev_fault_code_);
+        prev_latched_ = r.dbg.fault_latched();
+        prev_fault_code_ = r.dbg.fault_code;
+
+        bool emitted = true;
+        if (edge) {
+            ++triggers_;
+            Entry e;
+            while (history_.pop(e)) {   // 이미 찍은 것(간축/이전 capture)은 건너뜀
+                if (!e.emitted && e.rec.t_us + cfg_.pre_trigger_us >= r.t_us) emit(e.rec, LogEmit::PreTrigger);
+            }
+            emit(r, LogEmit::Trigger);
+            capture_until_us_ = r.t_us + cfg_.post_trigger_us;
+            capturing_ = true;
+            last_decim_us_ = r.t_us;
+        } else if (capturing_ && r.t_us <= capture_until_us_) {
+            emit(r, LogEmit::PostTrigger);
+        } else if (!has_decim_ || r.t_us - last_decim_us_ >= cfg_.decimate_period_us) {
+            capturing_ = false;
+            has_decim_ = true;
+            last_decim_us_ = r.t_us;
+            emit(r, LogEmit::Decimated);
+        } else {
+            capturing_ = false;
+            emitted = false;
+        }
+        history_.push(Entry{r, emitted});
+    }
+
+    std::uint64_t triggers() const { return triggers_; }
+
+private:
+    struct Entry {
+        LogRecord rec{};
+        bool emitted = false;
+    };
+
+    Config cfg_;
+    StaticRing<Entry, HistoryN> history_;
+
+    bool prev_latched_ = false;
+    std::uint16_t prev_fault_code_ = 0;
+    bool capturing_ = false;
+    std::uint64_t capture_until_us_ = 0;
+    bool has_decim_ = false;
+    std::uint64_t last_decim_us_ = 0;
+    std::uint64_t triggers_ = 0;
+};
+
+// 한 줄 포맷 (기존 main console 로그와 같은 필드)
+inline void format_log_line(std::ostream& os, const LogRecord& r, LogEmit kind) {
+    static constexpr const char* TAG[] = {"   ", "pre", "!!!", "   "};
+    if (kind == LogEmit::Trigger) {
+        const FaultReason fr = static_cast<FaultReason>(r.dbg.fault_code);
+        os << "!!! FAULT LATCHED: " << fault_name(fr) << " (code=" << r.dbg.fault_code << ")\n";
+    }
+    os << TAG[static_cast<int>(kind)]
+       << " [t=" << std::fixed << std::setprecision(2) << r.t_us / 1e6 << "s]"
+       << std::defaultfloat << std::setprecision(6)
+       << " state=" << state_name(static_cast<State>(r.dbg.state))
+       << " drive_en=" << (r.drive_enable ? 1 : 0)
+       << " comms_filt=" << (r.dbg.comms_ok_filtered() ? 1 : 0)
+       << " fault_latch=" << (r.dbg.fault_latched() ? 1 : 0)
+       << " fault_code=" << r.out.fault_code
+       << " | vel=" << r.velocity
+       << " motor_cmd=" << r.out.motor_cmd
+       << " integ=" << r.dbg.integ
+       << " windup_block=" << (r.dbg.would_worsen() ? 1 : 0)
+       << " hb=" << r.heartbeat
+       << "\n";
+}
+
+class LogSink final : public IOutputSink {
+public:
+    static constexpr std::size_t RING_SIZE = 1024;     // 10ms tick 기준 ~10s 여유
+    static constexpr std::size_t HISTORY_SIZE = 256;   // pre-trigger 2s @ 100Hz + 여유
+    using Trigger = LogTrigger<HISTORY_SIZE>;
+
+    // core/in: write() 시점의 debug / 입력을 같이 남김 (PlantOutputSink처럼 공유 객체 참조)
+    LogSink(const ControllerCore& core, const Inputs& in, std::ostream& os)
+        : LogSink(core, in, os, Trigger::Config{}) {}
+    LogSink(const ControllerCore& core, const Inputs& in, std::ostream& os, Trigger::Config cfg)
+        : core_(core), in_(in), os_(os), trigger_(cfg) {
+        // 할당은 여기서 끝 (control loop 중 할당 없음)
+        ring_ = std::make_unique<SpscRing<LogRecord, RING_SIZE>>();
+        writer_ = std::thread([this] { writer_loop_(); });
+    }
+
+    ~LogSink() override { stop(); }
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    // diag task의 heartbeat 카운터 (write와 같은 스레드에서 갱신되는 것, nullptr = 안 씀)
+    void set_heartbeat(const std::uint32_t* hb) { heartbeat_ = hb; }
+
+    // control thread: 복사 1회 + atomic store
+    void write(const OutputFrame& frame) override {
+        LogRecord r;
+        r.t_us = frame.t_us;
+        r.out = PackedOutputs::pack(frame.out);
+        r.dbg = LogDebug::pack(core_.debug());
+        r.velocity = in_.velocity;
+        r.target_velocity = in_.target_velocity;
+        r.drive_enable = in_.drive_enable;
+        r.comms_ok = in_.comms_ok;
+        r.heartbeat = heartbeat_ ? *heartbeat_ : 0;
+        if (!ring_->try_push(r)) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 남은 레코드 다 찍고 writer 종료 (이후 write는 ring에만 쌓임)
+    void stop() {
+        if (!writer_.joinable()) return;
+        stop_.store(true, std::memory_order_release);
+        writer_.join();
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t emitted() const { return emitted_.load(std::memory_order_relaxed); }
+    std::uint64_t triggers() const { return triggers_.load(std::memory_order_relaxed); }
+
+private:
+    std::size_t drain_once_() {
+        std::size_t n = 0;
+        LogRecord r;
+        while (ring_->try_pop(r)) {
+            trigger_.feed(r, [this](const LogRecord& rec, LogEmit kind) {
+                format_log_line(os_, rec, kind);
+                emitted_.fetch_add(1, std::memory_order_relaxed);
+            });
+            ++n;
+        }
+        triggers_.store(trigger_.triggers(), std::memory_order_relaxed);
+        return n;
+    }
+
+    void writer_loop_() {
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (drain_once_() == 0) {
+                os_.flush();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        drain_once_();
+        os_.flush();
+    }
+
+    const ControllerCore& core_;
+    const Inputs& in_;
+    std::ostream& os_;
+    const std::uint32_t* heartbeat_ = nullptr;
+
+    std::unique_ptr<SpscRing<LogRecord, RING_SIZE>> ring_;
+    Trigger trigger_;   // writer thread 전용
+
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> emitted_{0};
+    std::atomic<std::uint64_t> triggers_{0};
+
+    std::thread writer_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "input_source.hpp"
+#include "../clock.hpp"
+
+// =====================
+// 여러 IInputSource를 priority + freshness로 합치는 mux (예: teleop > autonomy > scenario)
+// - read()마다 모든 source를 poll (각자 slot의 InputFrame에 바로 받음, 큐/스레드 없음)
+// - source별 staleness timeout: 마지막 valid 프레임 후 timeout_us 넘으면 stale
+//   (timeout_us = 0 이면 한 번 받은 뒤로 계속 fresh)
+// - fresh인 source 중 priority가 가장 큰 것 선택 (같으면 먼저 add한 것)
+//   -> 고 priority source가 끊기면 다음 source로 바로 넘어감
+// - 출력 comms_ok = 선택된 source의 comms_ok, fresh source가 하나도 없으면
+//   마지막 선택 프레임을 그대로 두고 comms_ok = false, valid = false
+// - slot은 고정 배열 (N개), 할당/대기 없음
+// =====================
+template <std::size_t N>
+class MuxInputSource final : public IInputSource {
+public:
+    static constexpr int NONE = -1;
+
+    explicit MuxInputSource(const IClock& clock) : clock_(clock) {}
+
+    // 가득 찼으면 false
+    bool add(IInputSource& src, int priority, std::uint64_t timeout_us) {
+        if (count_ == N) return false;
+        Slot& s = slots_[count_++];
+        s.src = &src;
+        s.priority = priority;
+        s.timeout_us = timeout_us;
+        return true;
+    }
+
+    // fresh source가 없어도 한 번이라도 받았으면 true (comms_ok = false 프레임)
+    bool read(InputFrame& frame) override {
+        const std::uint64_t now = clock_.now_us();
+
+        int best = NONE;
+        for (std::size_t i = 0; i < count_; ++i) {
+            Slot& s = slots_[i];
+            if (s.src->read(s.frame) && s.frame.valid) {
+                s.received = true;
+                s.last_us = now;
+            }
+            if (fresh_(s, now) && (best == NONE || s.priority > slots_[best].priority))
+                best = static_cast<int>(i);
+        }
+
+        if (best != active_) {
+            if (best != NONE && active_ != NONE) ++switches_;
+            active_ = best;
+        }
+
+        if (best != NONE) {
+            last_ = best;
+            frame = slots_[best].frame;
+            return true;
+        }
+        if (last_ == NONE) return false;
+
+        frame = slots_[last_].frame;
+        frame.in.comms_ok = false;
+        frame.valid = false;
+        return true;
+    }
+
+    std::size_t size() const { return count_; }
+    int active() const { return active_; }              // 이번 read에서 선택된 slot (없으면 NONE)
+    std::uint64_t switches() const { return switches_; } // source 간 전환 횟수
+    bool fresh(std::size_t i) const { return i < count_ && fresh_(slots_[i], clock_.now_us()); }
+
+private:
+    struct Slot {
+        IInputSource* src = nullptr;
+        int priority = 0;
+        std::uint64_t timeout_us = 0;
+        std::uint64_t last_us = 0;
+        bool received = false;
+        InputFrame frame{};
+    };
+
+    static bool fresh_(const Slot& s, std::uint64_t now) {
+        return s.received && (s.timeout_us == 0 || now - s.last_us <= s.timeout_us);
+    }
+
+    const IClock& clock_;
+    std::array<Slot, N> slots_{};
+    std::size_t count_ = 0;
+
+    int active_ = NONE;
+    int last_ = NONE;
+    std::uint64_t switches_ = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include "../main_inputs_outputs.hpp"
+#include "../packed_io.hpp"
 
 // Outputs + 메타 묶음
 struct OutputFrame {
@@ -8,6 +9,15 @@ struct OutputFrame {
     std::uint64_t t_us = 0;
 };
 
+// ring / 스레드 경계용 (32B -> 24B)
+struct PackedOutputFrame {
+    PackedOutputs out{};
+    std::uint64_t t_us = 0;
+
+    static PackedOutputFrame pack(const OutputFrame& f) { return PackedOutputFrame{PackedOutputs::pack(f.out), f.t_us}; }
+    OutputFrame unpack() const { return OutputFrame{out.unpack(), t_us}; }
+};
+
 class IOutputSink {
 public:
     virtual ~IOutputSink() = default;
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "input_source.hpp"
+#include "output_sink.hpp"
+#include "../util/spsc_ring.hpp"
+
+// =====================
+// SpscRing <-> IInputSource / IOutputSink (스레드 경계)
+// - SpscInputSource : consumer 쪽 (control thread), ring에 쌓인 프레임 중 최신 것만 사용
+// - SpscOutputSink  : producer 쪽 (control thread), ring이 가득 차면 버리고 dropped() 증가
+// - ring 원소는 Packed*Frame (slot 1개 <= cache line), unpack은 최신 1개만
+// - 둘 다 wait-free, 할당 없음 (ring은 밖에서 소유)
+// =====================
+
+template <std::size_t N>
+class SpscInputSource final : public IInputSource {
+public:
+    using Ring = SpscRing<PackedInputFrame, N>;
+
+    explicit SpscInputSource(Ring& ring) : ring_(ring) {}
+
+    // 새 프레임이 없으면 false (frame은 그대로)
+    bool read(InputFrame& frame) override {
+        PackedInputFrame f;
+        bool got = false;
+        while (ring_.try_pop(f)) {
+            got = true;
+            ++received_;
+        }
+        if (got) frame = f.unpack();
+        return got;
+    }
+
+    std::uint64_t received() const { return received_; }
+
+private:
+    Ring& ring_;
+    std::uint64_t received_ = 0;
+};
+
+template <std::size_t N>
+class SpscOutputSink final : public IOutputSink {
+public:
+    using Ring = SpscRing<PackedOutputFrame, N>;
+
+    explicit SpscOutputSink(Ring& ring) : ring_(ring) {}
+
+    void write(const OutputFrame& frame) override {
+        if (!ring_.try_push(PackedOutputFrame::pack(frame))) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 다른 스레드(모니터)에서 읽어도 됨
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    Ring& ring_;
+    std::atomic<std::uint64_t> dropped_{0};
+};
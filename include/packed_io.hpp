@@ -0,0 +1,160 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "main_inputs_outputs.hpp"
+
+// =====================
+// Packed Inputs / Outputs (ring / log record / 스레드 경계용)
+// - bool들은 flag bit 하나씩 (InFlag / OutFlag), get/set으로 접근
+// - pack/unpack은 Inputs/Outputs와 손실 없이 왕복 (bit 단위 동일)
+// - CONTROLLER_FIXED_VELOCITY: velocity / target_velocity를 int32 고정소수점(1e-6 m/s)으로
+//   -> 20B, 대신 velocity가 1e-6 격자로 양자화됨 (격자 위 값은 그대로 왕복)
+// - ControllerCore::step 등 계산은 계속 Inputs/Outputs로 (경계에서만 pack)
+// =====================
+
+// Inputs 선언 순서 그대로
+enum class InFlag : std::uint8_t {
+    DriveEnable, LiftRequest, DumpRequest, OperatorAck, EstopButton,
+    BatteryOk, CommsOk,
+    CanTimeout, CriticalDtc, LiftTimeout, LiftSensorError, DumpTimeout, DumpSensorError,
+    NoActiveFault,
+    LiftComplete, DumpComplete,
+    StepActive,
+    Count
+};
+
+enum class OutFlag : std::uint8_t { DriveCmd, LiftCmd, DumpCmd, Count };
+
+// InFlag 순서의 Inputs bool 멤버 (pack/unpack, test 비교용)
+inline constexpr bool Inputs::* IN_FLAG_FIELDS[] = {
+    &Inputs::drive_enable, &Inputs::lift_request, &Inputs::dump_request, &Inputs::operator_ack,
+    &Inputs::estop_button,
+    &Inputs::battery_ok, &Inputs::comms_ok,
+    &Inputs::can_timeout, &Inputs::critical_dtc, &Inputs::lift_timeout, &Inputs::lift_sensor_error,
+    &Inputs::dump_timeout, &Inputs::dump_sensor_error,
+    &Inputs::no_active_fault,
+    &Inputs::lift_complete, &Inputs::dump_complete,
+    &Inputs::step_active,
+};
+static_assert(sizeof(IN_FLAG_FIELDS) / sizeof(IN_FLAG_FIELDS[0]) == static_cast<std::size_t>(InFlag::Count),
+              "IN_FLAG_FIELDS out of sync with InFlag");
+
+inline constexpr bool Outputs::* OUT_FLAG_FIELDS[] = {
+    &Outputs::drive_cmd, &Outputs::lift_cmd, &Outputs::dump_cmd,
+};
+static_assert(sizeof(OUT_FLAG_FIELDS) / sizeof(OUT_FLAG_FIELDS[0]) == static_cast<std::size_t>(OutFlag::Count),
+              "OUT_FLAG_FIELDS out of sync with OutFlag");
+
+// ---------- 고정소수점 velocity (1e-6 m/s, +-2147 m/s) ----------
+static constexpr double VEL_FIXED_PER_MPS = 1e6;
+
+inline std::int32_t velocity_to_fixed(double v) {
+    constexpr double LIM = 2147483647.0;
+    const double q = std::nearbyint(v * VEL_FIXED_PER_MPS);
+    if (!(q > -LIM)) return -2147483647;   // NaN도 여기
+    if (q > LIM) return 2147483647;
+    return static_cast<std::int32_t>(q);
+}
+
+inline double velocity_from_fixed(std::int32_t q) { return q / VEL_FIXED_PER_MPS; }
+
+#if defined(CONTROLLER_FIXED_VELOCITY)
+using packed_vel_t = std::int32_t;
+inline packed_vel_t pack_velocity(double v) { return velocity_to_fixed(v); }
+inline double unpack_velocity(packed_vel_t q) { return velocity_from_fixed(q); }
+#else
+using packed_vel_t = double;
+inline packed_vel_t pack_velocity(double v) { return v; }
+inline double unpack_velocity(packed_vel_t v) { return v; }
+#endif
+
+// =====================
+// PackedInputs: 32B (fixed velocity: 20B), Inputs는 56B
+// =====================
+struct PackedInputs {
+    packed_vel_t velocity = pack_velocity(0.0);
+    packed_vel_t target_velocity = pack_velocity(1.0);
+    std::int32_t scenario_id = 0;
+    std::int32_t step_id = 0;
+    std::uint32_t flags = pack_flags(Inputs{});
+
+    bool get(InFlag f) const { return (flags >> static_cast<unsigned>(f)) & 1u; }
+    void set(InFlag f, bool v) {
+        const std::uint32_t m = 1u << static_cast<unsigned>(f);
+        flags = v ? (flags | m) : (flags & ~m);
+    }
+
+    static std::uint32_t pack_flags(const Inputs& in) {
+        std::uint32_t m = 0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(InFlag::Count); ++i)
+            m |= static_cast<std::uint32_t>(in.*IN_FLAG_FIELDS[i]) << i;
+        return m;
+    }
+
+    static PackedInputs pack(const Inputs& in) {
+        PackedInputs p;
+        p.velocity = pack_velocity(in.velocity);
+        p.target_velocity = pack_velocity(in.target_velocity);
+        p.scenario_id = in.scenario_id;
+        p.step_id = in.step_id;
+        p.flags = pack_flags(in);
+        return p;
+    }
+
+    void unpack(Inputs& in) const {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(InFlag::Count); ++i)
+            in.*IN_FLAG_FIELDS[i] = (flags >> i) & 1u;
+        in.velocity = unpack_velocity(velocity);
+        in.target_velocity = unpack_velocity(target_velocity);
+        in.scenario_id = scenario_id;
+        in.step_id = step_id;
+    }
+
+    Inputs unpack() const {
+        Inputs in;
+        unpack(in);
+        return in;
+    }
+};
+
+// =====================
+// PackedOutputs: 16B, Outputs는 24B
+// - motor_cmd / fault_code는 Outputs와 같은 이름 (읽는 쪽 코드 그대로)
+// =====================
+struct PackedOutputs {
+    double motor_cmd = 0.0;
+    std::uint16_t fault_code = 0;
+    std::uint8_t flags = 0;
+
+    bool get(OutFlag f) const { return (flags >> static_cast<unsigned>(f)) & 1u; }
+    void set(OutFlag f, bool v) {
+        const std::uint8_t m = static_cast<std::uint8_t>(1u << static_cast<unsigned>(f));
+        flags = v ? static_cast<std::uint8_t>(flags | m) : static_cast<std::uint8_t>(flags & ~m);
+    }
+
+    static PackedOutputs pack(const Outputs& out) {
+        PackedOutputs p;
+        p.motor_cmd = out.motor_cmd;
+        p.fault_code = out.fault_code;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(OutFlag::Count); ++i)
+            p.flags = static_cast<std::uint8_t>(p.flags | (static_cast<unsigned>(out.*OUT_FLAG_FIELDS[i]) << i));
+        return p;
+    }
+
+    Outputs unpack() const {
+        Outputs out;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(OutFlag::Count); ++i)
+            out.*OUT_FLAG_FIELDS[i] = (flags >> i) & 1u;
+        out.motor_cmd = motor_cmd;
+        out.fault_code = fault_code;
+        return out;
+    }
+};
+
+static_assert(std::is_trivially_copyable<PackedInputs>::value, "PackedInputs must be POD");
+static_assert(std::is_trivially_copyable<PackedOutputs>::value, "PackedOutputs must be POD");
+static_assert(static_cast<unsigned>(InFlag::Count) <= 32, "InFlag does not fit in flags");
+static_assert(sizeof(PackedInputs) <= 32, "PackedInputs grew past half a cache line");
+static_assert(sizeof(PackedOutputs) <= 16, "PackedOutputs layout changed");
@@ -0,0 +1,312 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "pid.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PID_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// =====================
+// PID::compute와 같은 anti-windup clamp 법칙을 N개 loop에 한 번에 적용
+// - lane별 게인(kp/ki/kd) / 상태(integ/prev_error/first)는 SoA 배열
+// - AVX2(4 lane) / SSE2(2 lane) / scalar 중 실행 시점에 선택
+// - first / would_worsen / ki!=0 분기는 SIMD에서 mask로 처리
+// - 결과는 lane마다 PID::compute와 bit 단위로 동일 (FMA 미사용)
+// =====================
+class PIDBatch {
+public:
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    // PID::PIDDebug의 batch(SoA) 버전
+    struct Debug {
+        std::vector<double> error;
+        std::vector<double> integ;
+        std::vector<double> u_unsat;
+        std::vector<double> u_sat;
+        std::vector<std::uint8_t> would_worsen;
+    };
+
+    // lane별 게인
+    std::vector<double> kp, ki, kd;
+
+    // lane별 상태
+    std::vector<double> integ;
+    std::vector<double> prev_error;
+    std::vector<std::uint8_t> first;
+
+    // 제한값 (전 lane 공통, PID 기본값과 동일)
+    double integ_min = -5.0;
+    double integ_max = 5.0;
+    double output_min = -1.0;
+    double output_max = 1.0;
+
+    Debug dbg;
+
+    explicit PIDBatch(std::size_t n = 0, double p = 0.0, double i = 0.0, double d = 0.0)
+        : isa_(detect_isa()) {
+        resize(n, p, i, d);
+    }
+
+    // 새로 생긴 lane은 (p, i, d) 게인 + reset 상태
+    void resize(std::size_t n, double p, double i = 0.0, double d = 0.0) {
+        const std::size_t old = size();
+        kp.resize(n, p); ki.resize(n, i); kd.resize(n, d);
+        integ.resize(n); prev_error.resize(n); first.resize(n);
+        dbg.error.resize(n); dbg.integ.resize(n);
+        dbg.u_unsat.resize(n); dbg.u_sat.resize(n); dbg.would_worsen.resize(n);
+        for (std::size_t k = old; k < n; ++k) reset(k);
+    }
+
+    std::size_t size() const { return integ.size(); }
+
+    void set_gains(std::size_t k, double p, double i, double d) { kp[k] = p; ki[k] = i; kd[k] = d; }
+
+    void reset() {
+        for (std::size_t k = 0; k < size(); ++k) reset(k);
+    }
+
+    void reset(std::size_t k) {
+        integ[k] = 0.0;
+        prev_error[k] = 0.0;
+        first[k] = 1;
+        dbg.error[k] = 0.0; dbg.integ[k] = 0.0;
+        dbg.u_unsat[k] = 0.0; dbg.u_sat[k] = 0.0; dbg.would_worsen[k] = 0;
+    }
+
+    PID::PIDDebug debug(std::size_t k) const {
+        PID::PIDDebug d;
+        d.error = dbg.error[k];
+        d.integ = dbg.integ[k];
+        d.u_unsat = dbg.u_unsat[k];
+        d.u_sat = dbg.u_sat[k];
+        d.would_worsen = dbg.would_worsen[k] != 0;
+        return d;
+    }
+
+    static Isa detect_isa() {
+#if defined(PID_BATCH_X86)
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        return Isa::SSE2;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    Isa isa() const { return isa_; }
+    // 테스트/벤치에서 경로 강제 (지원 안 되는 ISA는 detect 결과로 내려감)
+    void set_isa(Isa isa) {
+        const Isa best = detect_isa();
+        isa_ = (static_cast<int>(isa) > static_cast<int>(best)) ? best : isa;
+    }
+
+    // target/current/u: 길이 size() 배열
+    // active가 있으면 active[k]==0인 lane은 상태/dbg/u를 건드리지 않음
+    void compute(const double* target, const double* current, double dt,
+                 double* u, const std::uint8_t* active = nullptr) {
+        const std::size_t n = size();
+        std::size_t k = 0;
+#if defined(PID_BATCH_X86)
+        if (isa_ == Isa::AVX2)      k = compute_avx2_(target, current, dt, u, active, n);
+        else if (isa_ == Isa::SSE2) k = compute_sse2_(target, current, dt, u, active, n);
+#endif
+        for (; k < n; ++k) {
+            if (active && !active[k]) continue;
+            u[k] = compute_one_(k, target[k], current[k], dt);
+        }
+    }
+
+private:
+    // scalar 기준 구현 (PID::compute 그대로)
+    double compute_one_(std::size_t k, double target, double current, double dt) {
+        const double error = target - current;
+
+        double derr = 0.0;
+        if (!first[k]) derr = (error - prev_error[k]) / dt;
+        prev_error[k] = error;
+        first[k] = 0;
+
+        const double u_unsat = kp[k] * error + ki[k] * integ[k] + kd[k] * derr;
+
+        const bool would_worsen =
+            (u_unsat > output_max && error > 0) ||
+            (u_unsat < output_min && error < 0);
+
+        if (ki[k] != 0.0 && !would_worsen) {
+            integ[k] += error * dt;
+            integ[k] = std::clamp(integ[k], integ_min, integ_max);
+        }
+
+        const double output = kp[k] * error + ki[k] * integ[k] + kd[k] * derr;
+        const double u_sat = std::clamp(output, output_min, output_max);
+
+        dbg.error[k] = error;
+        dbg.integ[k] = integ[k];
+        dbg.u_unsat[k] = u_unsat;
+        dbg.u_sat[k] = u_sat;
+        dbg.would_worsen[k] = would_worsen;
+
+        return u_sat;
+    }
+
+#if defined(PID_BATCH_X86)
+    // ---------- AVX2: 4 lane ----------
+    __attribute__((target("avx2")))
+    static __m256d mask4_(const std::uint8_t* b) {
+        std::uint32_t bytes;
+        std::memcpy(&bytes, b, sizeof(bytes));
+        const __m256i w = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(bytes)));
+        return _mm256_castsi256_pd(_mm256_cmpgt_epi64(w, _mm256_setzero_si256()));
+    }
+
+    // std::clamp(v, lo, hi) 와 동일: v < lo ? lo : (hi < v ? hi : v)
+    __attribute__((target("avx2")))
+    static __m256d clamp4_(__m256d v, __m256d lo, __m256d hi) {
+        const __m256d t = _mm256_blendv_pd(v, hi, _mm256_cmp_pd(hi, v, _CMP_LT_OQ));
+        return _mm256_blendv_pd(t, lo, _mm256_cmp_pd(v, lo, _CMP_LT_OQ));
+    }
+
+    __attribute__((target("avx2")))
+    static void put4_(double* dst, __m256d v, __m256d m) {
+        _mm256_storeu_pd(dst, _mm256_blendv_pd(_mm256_loadu_pd(dst), v, m));
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t compute_avx2_(const double* target, const double* current, double dt,
+                              double* u, const std::uint8_t* active, std::size_t n) {
+        const __m256d vdt = _mm256_set1_pd(dt);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d imin = _mm256_set1_pd(integ_min), imax = _mm256_set1_pd(integ_max);
+        const __m256d omin = _mm256_set1_pd(output_min), omax = _mm256_set1_pd(output_max);
+
+        std::size_t k = 0;
+        for (; k + 4 <= n; k += 4) {
+            const __m256d act = active ? mask4_(active + k) : _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            if (_mm256_movemask_pd(act) == 0) continue;
+
+            const __m256d p = _mm256_loadu_pd(&kp[k]);
+            const __m256d i = _mm256_loadu_pd(&ki[k]);
+            const __m256d d = _mm256_loadu_pd(&kd[k]);
+            const __m256d integ0 = _mm256_loadu_pd(&integ[k]);
+            const __m256d prev0 = _mm256_loadu_pd(&prev_error[k]);
+            const __m256d fst = mask4_(&first[k]);
+
+            const __m256d error = _mm256_sub_pd(_mm256_loadu_pd(target + k), _mm256_loadu_pd(current + k));
+            const __m256d derr = _mm256_andnot_pd(fst, _mm256_div_pd(_mm256_sub_pd(error, prev0), vdt));
+
+            const __m256d pe = _mm256_mul_pd(p, error);
+            const __m256d dd = _mm256_mul_pd(d, derr);
+            const __m256d u_unsat = _mm256_add_pd(_mm256_add_pd(pe, _mm256_mul_pd(i, integ0)), dd);
+
+            const __m256d worsen = _mm256_or_pd(
+                _mm256_and_pd(_mm256_cmp_pd(u_unsat, omax, _CMP_GT_OQ), _mm256_cmp_pd(error, zero, _CMP_GT_OQ)),
+                _mm256_and_pd(_mm256_cmp_pd(u_unsat, omin, _CMP_LT_OQ), _mm256_cmp_pd(error, zero, _CMP_LT_OQ)));
+            const __m256d upd = _mm256_andnot_pd(worsen, _mm256_cmp_pd(i, zero, _CMP_NEQ_UQ));
+
+            const __m256d integ_new = clamp4_(_mm256_add_pd(integ0, _mm256_mul_pd(error, vdt)), imin, imax);
+            const __m256d integ1 = _mm256_blendv_pd(integ0, integ_new, upd);
+
+            const __m256d output = _mm256_add_pd(_mm256_add_pd(pe, _mm256_mul_pd(i, integ1)), dd);
+            const __m256d u_sat = clamp4_(output, omin, omax);
+
+            // active lane만 반영
+            put4_(&integ[k], integ1, act);
+            put4_(&prev_error[k], error, act);
+            put4_(u + k, u_sat, act);
+            put4_(&dbg.error[k], error, act);
+            put4_(&dbg.integ[k], integ1, act);
+            put4_(&dbg.u_unsat[k], u_unsat, act);
+            put4_(&dbg.u_sat[k], u_sat, act);
+
+            const int am = _mm256_movemask_pd(act);
+            const int wm = _mm256_movemask_pd(worsen);
+            for (int j = 0; j < 4; ++j) {
+                if (!((am >> j) & 1)) continue;
+                first[k + j] = 0;
+                dbg.would_worsen[k + j] = static_cast<std::uint8_t>((wm >> j) & 1);
+            }
+        }
+        return k;
+    }
+
+    // ---------- SSE2: 2 lane (blendv 없음 -> and/andnot/or) ----------
+    static __m128d mask2_(const std::uint8_t* b) {
+        return _mm_castsi128_pd(_mm_set_epi64x(b[1] ? -1 : 0, b[0] ? -1 : 0));
+    }
+
+    static __m128d select2_(__m128d a, __m128d b, __m128d m) {
+        return _mm_or_pd(_mm_andnot_pd(m, a), _mm_and_pd(m, b));
+    }
+
+    static __m128d clamp2_(__m128d v, __m128d lo, __m128d hi) {
+        const __m128d t = select2_(v, hi, _mm_cmplt_pd(hi, v));
+        return select2_(t, lo, _mm_cmplt_pd(v, lo));
+    }
+
+    static void put2_(double* dst, __m128d v, __m128d m) {
+        _mm_storeu_pd(dst, select2_(_mm_loadu_pd(dst), v, m));
+    }
+
+    std::size_t compute_sse2_(const double* target, const double* current, double dt,
+                              double* u, const std::uint8_t* active, std::size_t n) {
+        const __m128d vdt = _mm_set1_pd(dt);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d imin = _mm_set1_pd(integ_min), imax = _mm_set1_pd(integ_max);
+        const __m128d omin = _mm_set1_pd(output_min), omax = _mm_set1_pd(output_max);
+
+        std::size_t k = 0;
+        for (; k + 2 <= n; k += 2) {
+            const __m128d act = active ? mask2_(active + k) : _mm_castsi128_pd(_mm_set1_epi64x(-1));
+            if (_mm_movemask_pd(act) == 0) continue;
+
+            const __m128d p = _mm_loadu_pd(&kp[k]);
+            const __m128d i = _mm_loadu_pd(&ki[k]);
+            const __m128d d = _mm_loadu_pd(&kd[k]);
+            const __m128d integ0 = _mm_loadu_pd(&integ[k]);
+            const __m128d prev0 = _mm_loadu_pd(&prev_error[k]);
+            const __m128d fst = mask2_(&first[k]);
+
+            const __m128d error = _mm_sub_pd(_mm_loadu_pd(target + k), _mm_loadu_pd(current + k));
+            const __m128d derr = _mm_andnot_pd(fst, _mm_div_pd(_mm_sub_pd(error, prev0), vdt));
+
+            const __m128d pe = _mm_mul_pd(p, error);
+            const __m128d dd = _mm_mul_pd(d, derr);
+            const __m128d u_unsat = _mm_add_pd(_mm_add_pd(pe, _mm_mul_pd(i, integ0)), dd);
+
+            const __m128d worsen = _mm_or_pd(
+                _mm_and_pd(_mm_cmpgt_pd(u_unsat, omax), _mm_cmpgt_pd(error, zero)),
+                _mm_and_pd(_mm_cmplt_pd(u_unsat, omin), _mm_cmplt_pd(error, zero)));
+            const __m128d upd = _mm_andnot_pd(worsen, _mm_cmpneq_pd(i, zero));
+
+            const __m128d integ_new = clamp2_(_mm_add_pd(integ0, _mm_mul_pd(error, vdt)), imin, imax);
+            const __m128d integ1 = select2_(integ0, integ_new, upd);
+
+            const __m128d output = _mm_add_pd(_mm_add_pd(pe, _mm_mul_pd(i, integ1)), dd);
+            const __m128d u_sat = clamp2_(output, omin, omax);
+
+            put2_(&integ[k], integ1, act);
+            put2_(&prev_error[k], error, act);
+            put2_(u + k, u_sat, act);
+            put2_(&dbg.error[k], error, act);
+            put2_(&dbg.integ[k], integ1, act);
+            put2_(&dbg.u_unsat[k], u_unsat, act);
+            put2_(&dbg.u_sat[k], u_sat, act);
+
+            const int am = _mm_movemask_pd(act);
+            const int wm = _mm_movemask_pd(worsen);
+            for (int j = 0; j < 2; ++j) {
+                if (!((am >> j) & 1)) continue;
+                first[k + j] = 0;
+                dbg.would_worsen[k + j] = static_cast<std::uint8_t>((wm >> j) & 1);
+            }
+        }
+        return k;
+    }
+#endif
+
+    Isa isa_ = Isa::Scalar;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// =====================
+// Single-producer / single-consumer lock-free ring
+// - 용량 N은 compile-time (2의 거듭제곱), 생성 후 할당 없음
+// - try_push / try_pop 모두 wait-free (가득/비었으면 false 즉시 반환)
+// - producer 1개 스레드, consumer 1개 스레드에서만 사용
+// =====================
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    // ----- producer -----
+    bool try_push(const T& v) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == N) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == N) return false;
+        }
+        buf_[tail & (N - 1)] = v;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ----- consumer -----
+    bool try_pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        out = buf_[head & (N - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 어느 쪽에서 불러도 되지만 근사값
+    std::size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty_approx() const { return size_approx() == 0; }
+
+private:
+    // producer 쪽 (tail 소유, head 캐시)
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+
+    // consumer 쪽 (head 소유, tail 캐시)
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+
+    alignas(64) std::array<T, N> buf_{};
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// =====================
+// 고정 용량 FIFO (단일 스레드, 용량은 컴파일 타임)
+// - storage는 객체 안의 std::array -> heap 할당 없음
+// - 가득 찼을 때 정책:
+//   DropOldest   : 가장 오래된 항목을 덮어씀 (최신 명령 우선)
+//   DropNewest   : 새 항목을 버림
+//   CountAndFlag : 새 항목을 버리고 sticky flag 세움 (DTC로 올리는 용도)
+//   모든 정책에서 overflows() 카운트 증가
+// - 스레드 간 전달은 SpscRing 사용
+// =====================
+
+enum class OverflowPolicy : std::uint8_t { DropOldest, DropNewest, CountAndFlag };
+
+template <class T, std::size_t N>
+class StaticRing {
+    static_assert(N > 0, "StaticRing capacity must be > 0");
+
+public:
+    explicit StaticRing(OverflowPolicy policy = OverflowPolicy::DropNewest) : policy_(policy) {}
+
+    static constexpr std::size_t capacity() { return N; }
+
+    void set_policy(OverflowPolicy p) { policy_ = p; }
+    OverflowPolicy policy() const { return policy_; }
+
+    // 항목이 들어갔으면 true (DropOldest는 항상 true)
+    bool push(const T& v) {
+        if (count_ == N) {
+            ++overflows_;
+            if (policy_ == OverflowPolicy::CountAndFlag) flag_ = true;
+            if (policy_ != OverflowPolicy::DropOldest) return false;
+            head_ = wrap_(head_ + 1);
+            --count_;
+        }
+        buf_[wrap_(head_ + count_)] = v;
+        ++count_;
+        return true;
+    }
+
+    bool pop(T& out) {
+        if (count_ == 0) return false;
+        out = buf_[head_];
+        head_ = wrap_(head_ + 1);
+        --count_;
+        return true;
+    }
+
+    // out[0..max)에 오래된 순으로 복사 (연속 구간 최대 2번 복사)
+    std::size_t drain(T* out, std::size_t max) {
+        const std::size_t n = std::min(max, count_);
+        const std::size_t first = std::min(n, N - head_);
+        std::copy_n(buf_.data() + head_, first, out);
+        std::copy_n(buf_.data(), n - first, out + first);
+        head_ = wrap_(head_ + n);
+        count_ -= n;
+        return n;
+    }
+
+    void clear() { head_ = 0; count_ = 0; }
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == N; }
+
+    std::uint64_t overflows() const { return overflows_; }
+    bool overflow_flag() const { return flag_; }
+    void clear_overflow_flag() { flag_ = false; }
+
+private:
+    static constexpr std::size_t wrap_(std::size_t i) { return i >= N ? i - N : i; }
+
+    std::array<T, N> buf_{};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+
+    OverflowPolicy policy_;
+    std::uint64_t overflows_ = 0;
+    bool flag_ = false;
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =====================
+// Work-stealing thread pool
+// - worker마다 자기 deque: 자기 것은 뒤(LIFO)에서, 남의 것은 앞(FIFO)에서 훔침
+// - 외부 submit은 round-robin으로 분배
+// - gain sweep / 병렬 시나리오 실행용
+// =====================
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        queues_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) workers_.emplace_back([this, i] { worker_loop_(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lk(wake_m_);
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // worker 안에서 호출하면 자기 queue로, 밖이면 round-robin
+    void submit(Task task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        // queued_는 task를 queue에 넣기 전에 올림: 넣자마자 다른 worker가 꺼내 --queued_ 해도 0 아래로 안 내려감
+        // (잠깐 queued_ > 0 인데 queue가 빈 구간은 worker가 한 바퀴 더 돌 뿐)
+        {
+            std::lock_guard<std::mutex> lk(wake_m_);
+            ++queued_;
+        }
+
+        const int self = (tls_pool_ == this) ? tls_index_ : -1;
+        const std::size_t qi = (self >= 0)
+            ? static_cast<std::size_t>(self)
+            : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lk(queues_[qi]->m);
+            queues_[qi]->q.push_back(std::move(task));
+        }
+        wake_cv_.notify_one();
+    }
+
+    // submit한 task가 전부 끝날 때까지 대기 (worker 밖에서만 호출)
+    void wait_idle() {
+        std::unique_lock<std::mutex> lk(done_m_);
+        done_cv_.wait(lk, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+    // [0, n)을 chunk 크기 task로 나눠 fn(i) 실행 후 대기
+    template <typename Fn>
+    void parallel_for(std::size_t n, std::size_t chunk, Fn fn) {
+        if (chunk == 0) chunk = 1;
+        for (std::size_t lo = 0; lo < n; lo += chunk) {
+            const std::size_t hi = std::min(n, lo + chunk);
+            submit([lo, hi, &fn] {
+                for (std::size_t i = lo; i < hi; ++i) fn(i);
+            });
+        }
+        wait_idle();
+    }
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<Task> q;
+    };
+
+    bool pop_local_(std::size_t i, Task& out) {
+        std::lock_guard<std::mutex> lk(queues_[i]->m);
+        if (queues_[i]->q.empty()) return false;
+        out = std::move(queues_[i]->q.back());
+        queues_[i]->q.pop_back();
+        return true;
+    }
+
+    bool steal_(std::size_t thief, Task& out) {
+        const std::size_t n = queues_.size();
+        for (std::size_t k = 1; k < n; ++k) {
+            const std::size_t v = (thief + k) % n;
+            std::lock_guard<std::mutex> lk(queues_[v]->m);
+            if (queues_[v]->q.empty()) continue;
+            out = std::move(queues_[v]->q.front());
+            queues_[v]->q.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void worker_loop_(unsigned index) {
+        tls_pool_ = this;
+        tls_index_ = static_cast<int>(index);
+
+        Task task;
+        while (true) {
+            if (pop_local_(index, task) || steal_(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lk(wake_m_);
+                    --queued_;
+                }
+                task();
+                task = nullptr;
+
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lk(done_m_);
+                    done_cv_.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lk(wake_m_);
+            wake_cv_.wait(lk, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<std::size_t> next_{0};
+    std::atomic<std::size_t> pending_{0};   // submit됐지만 아직 안 끝난 task 수
+
+    std::mutex wake_m_;
+    std::condition_variable wake_cv_;
+    std::size_t queued_ = 0;                // queue에 들어있는 task 수 (wake_m_ 보호)
+    bool stop_ = false;
+
+    std::mutex done_m_;
+    std::condition_variable done_cv_;
+
+    static inline thread_local WorkStealingPool* tls_pool_ = nullptr;
+    static inline thread_local int tls_index_ = -1;
+};
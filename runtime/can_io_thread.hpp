@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "clock.hpp"
+#include "io/spsc_io.hpp"
+#include "drivers/can_port.hpp"
+#include "drivers/fakecan_codec.hpp"
+
+// =====================
+// CAN I/O thread: port(FakeCanBus / SocketCAN)를 혼자 소유
+//   RX: port.receive -> decode_cmd(0x100) -> PackedInputFrame -> SpscRing -> control thread
+//   TX: control thread -> SpscRing -> PackedOutputFrame -> encode_act(0x200) (+ fault_code 바뀌면 0x300)
+//       -> port.send
+// - control thread는 input()/output() (IInputSource/IOutputSink)만 만짐
+//   -> control 쪽 cout/logging이 느려도 CAN 수신은 I/O 주기대로 계속됨
+// - 양방향 모두 wait-free, 가득 차면 버리고 카운트 (어느 쪽도 대기 안 함)
+// - sim hook: 매 주기 receive 전에 I/O thread에서 호출 (가상 VCU/모터 node가 bus를 만질 때)
+// =====================
+
+template <std::size_t RxN = 64, std::size_t TxN = 64>
+class CanIoThread {
+public:
+    static constexpr std::size_t RX_BURST = 64;   // 주기당 최대 수신 프레임
+    static constexpr std::size_t TX_BURST = 16;   // 주기당 최대 송신 프레임
+
+    struct Config {
+        std::uint64_t period_us = 1000;   // I/O 주기 (control 10ms보다 짧게)
+    };
+
+    struct Stats {
+        std::uint64_t cycles = 0;
+        std::uint64_t rx_frames = 0;      // port에서 받은 전체 프레임
+        std::uint64_t rx_cmd = 0;         // 0x100 -> InputFrame
+        std::uint64_t rx_ring_drops = 0;  // control thread가 못 따라와서 버린 InputFrame
+        std::uint64_t tx_frames = 0;      // port로 나간 프레임
+        std::uint64_t tx_port_drops = 0;  // port가 거절한 프레임
+    };
+
+    using SimHook = std::function<void(std::uint64_t now_us)>;
+
+    CanIoThread(ICanPort& port, IClock& clock) : CanIoThread(port, clock, Config{}) {}
+    CanIoThread(ICanPort& port, IClock& clock, Config cfg)
+        : port_(port), clock_(clock), cfg_(cfg), input_(in_ring_), output_(out_ring_) {}
+
+    ~CanIoThread() { stop(); }
+
+    CanIoThread(const CanIoThread&) = delete;
+    CanIoThread& operator=(const CanIoThread&) = delete;
+
+    // start() 전에만
+    void set_sim_hook(SimHook hook) { hook_ = std::move(hook); }
+
+    void start() {
+        if (thread_.joinable()) return;
+        stop_.store(false, std::memory_order_release);
+        thread_ = std::thread([this] { loop_(); });
+    }
+
+    // 남은 OutputFrame은 내보내고 종료
+    void stop() {
+        if (!thread_.joinable()) return;
+        stop_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+
+    // control thread 쪽 끝
+    IInputSource& input() { return input_; }
+    IOutputSink& output() { return output_; }
+    const SpscOutputSink<TxN>& output_sink() const { return output_; }
+
+    // 아무 스레드에서나 (relaxed, 근사값)
+    Stats stats() const {
+        Stats s;
+        s.cycles = cycles_.load(std::memory_order_relaxed);
+        s.rx_frames = rx_frames_.load(std::memory_order_relaxed);
+        s.rx_cmd = rx_cmd_.load(std::memory_order_relaxed);
+        s.rx_ring_drops = rx_ring_drops_.load(std::memory_order_relaxed);
+        s.tx_frames = tx_frames_.load(std::memory_order_relaxed);
+        s.tx_port_drops = tx_port_drops_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    void loop_() {
+        std::uint64_t next = clock_.now_us();
+        while (!stop_.load(std::memory_order_acquire)) {
+            const std::uint64_t now = clock_.now_us();
+            if (hook_) hook_(now);
+            rx_once_(now);
+            tx_once_(now);
+            cycles_.fetch_add(1, std::memory_order_relaxed);
+
+            next += cfg_.period_us;
+            if (next < now) next = now;   // 늦었으면 밀린 주기는 건너뜀
+            clock_.sleep_until_us(next);
+        }
+        tx_once_(clock_.now_us());
+    }
+
+    void rx_once_(std::uint64_t now) {
+        const std::size_t n = port_.receive(rx_buf_, RX_BURST, now);
+        std::uint64_t cmd = 0, drops = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const CanFrame& f = rx_buf_[i];
+            if (!can_msg::Cmd::match(f)) continue;
+            decode_cmd(f, cmd_);   // 0x100이 싣지 않는 필드는 기본값 그대로
+            // port t_us는 SteadyClock 시간축 (SocketCanPort가 kernel timestamp를 변환), 0이면 now
+            const PackedInputFrame in{PackedInputs::pack(cmd_), f.t_us ? f.t_us : now, true};
+            if (in_ring_.try_push(in)) ++cmd;
+            else ++drops;
+        }
+        rx_frames_.fetch_add(n, std::memory_order_relaxed);
+        rx_cmd_.fetch_add(cmd, std::memory_order_relaxed);
+        rx_ring_drops_.fetch_add(drops, std::memory_order_relaxed);
+    }
+
+    void tx_once_(std::uint64_t now) {
+        std::size_t k = 0;
+        PackedOutputFrame p;
+        while (k + 2 <= TX_BURST && out_ring_.try_pop(p)) {
+            const OutputFrame o = p.unpack();
+            CanFrame act = encode_act(o.out);
+            act.t_us = o.t_us;
+            tx_buf_[k++] = act;
+            if (o.out.fault_code != last_fault_code_) {
+                CanFrame diag = encode_diag(o.out);
+                diag.t_us = o.t_us;
+                tx_buf_[k++] = diag;
+                last_fault_code_ = o.out.fault_code;
+            }
+        }
+        if (k == 0) return;
+        const std::size_t sent = port_.send(tx_buf_, k, now);
+        tx_frames_.fetch_add(sent, std::memory_order_relaxed);
+        tx_port_drops_.fetch_add(k - sent, std::memory_order_relaxed);
+    }
+
+    ICanPort& port_;
+    IClock& clock_;
+    Config cfg_;
+    SimHook hook_;
+
+    SpscRing<PackedInputFrame, RxN> in_ring_;
+    SpscRing<PackedOutputFrame, TxN> out_ring_;
+    SpscInputSource<RxN> input_;
+    SpscOutputSink<TxN> output_;
+
+    // I/O thread 전용
+    Inputs cmd_{};
+    std::uint16_t last_fault_code_ = 0;
+    CanFrame rx_buf_[RX_BURST];
+    CanFrame tx_buf_[TX_BURST];
+
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> cycles_{0};
+    std::atomic<std::uint64_t> rx_frames_{0};
+    std::atomic<std::uint64_t> rx_cmd_{0};
+    std::atomic<std::uint64_t> rx_ring_drops_{0};
+    std::atomic<std::uint64_t> tx_frames_{0};
+    std::atomic<std::uint64_t> tx_port_drops_{0};
+
+    std::thread thread_;
+};
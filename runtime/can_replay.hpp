@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "clock.hpp"
+#include "comms_watchdog.hpp"
+#include "controller_core.hpp"
+#include "plant.hpp"
+#include "drivers/can_replay_io.hpp"
+
+// =====================
+// capture replay 회귀: 기록된 RX로 core를 다시 돌려 나온 0x200 == 기록된 0x200 인지 (bit 단위)
+// - fakecan_demo 루프와 같은 순서: RX decode -> comms watchdog -> core.step -> plant.step -> encode_act
+// - CAN에 없는 입력은 결정적으로 재계산: velocity = plant 재시뮬,
+//   comms_ok = 기록된 버스 시간 기준 watchdog (실시간 재생이어도 sleep 오차 영향 없음)
+//   (버스 overflow DTC는 기록되지 않음 -> 그런 구간은 mismatch로 드러남)
+// =====================
+
+struct CanReplayResult {
+    std::uint64_t ticks = 0;
+    std::uint64_t mismatches = 0;
+    std::int64_t first_mismatch_tick = -1;
+    CanFrame first_expected{};
+    CanFrame first_got{};
+
+    bool ok() const { return ticks > 0 && mismatches == 0; }
+};
+
+inline bool same_can_payload(const CanFrame& a, const CanFrame& b) {
+    return a.id == b.id && a.dlc == b.dlc && std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+}
+
+inline CanReplayResult replay_can_capture(CanReplayInputSource& src, ControllerCore& core, Plant& plant,
+                                          double dt_s = 0.01) {
+    CanReplayResult res;
+    VirtualClock bus_clock;
+    std::optional<CommsWatchdog> comms;   // 첫 tick 시각에 시작 (demo는 루프 직전에 생성)
+
+    InputFrame f;
+    while (src.read(f)) {
+        bus_clock.sleep_until_us(f.t_us);
+        if (!comms) comms.emplace(bus_clock);
+        if (src.tick_rx()) comms->kick();
+
+        Inputs& in = f.in;
+        in.comms_ok = comms->ok();
+        in.velocity = plant.vel;
+
+        const Outputs out = core.step(in, dt_s);
+        plant.step(out, in, dt_s);
+
+        const CanFrame got = encode_act(out);
+        if (!same_can_payload(got, src.expected_act())) {
+            if (res.mismatches++ == 0) {
+                res.first_mismatch_tick = static_cast<std::int64_t>(res.ticks);
+                res.first_expected = src.expected_act();
+                res.first_got = got;
+            }
+        }
+        ++res.ticks;
+    }
+    return res;
+}
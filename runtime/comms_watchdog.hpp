@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include "clock.hpp"
+
+// 마지막 command 수신 후 timeout 이내면 comms_ok (clock 기준)
+class CommsWatchdog {
+public:
+  explicit CommsWatchdog(const IClock& clock, uint64_t timeout_us = 100000) // 100ms
+    : clock_(clock), timeout_us_(timeout_us), last_cmd_us_(clock.now_us()) {}
+
+  void kick() { last_cmd_us_ = clock_.now_us(); }
+
+  bool ok() const { return (clock_.now_us() - last_cmd_us_) <= timeout_us_; }
+
+private:
+  const IClock& clock_;
+  uint64_t timeout_us_;
+  uint64_t last_cmd_us_;
+};
@@ -1,34 +1,60 @@
 #include <iostream>
-#include <thread>
 #include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
 
 #include "controller_core.hpp"
 #include "plant.hpp"
+#include "clock.hpp"
 #include "drivers/fakecan_bus.hpp"
 #include "drivers/fakecan_codec.hpp"
+#include "drivers/can_capture.hpp"
+#include "comms_watchdog.hpp"
+#include "rt/alloc_trap.hpp"
 
-static uint64_t now_us() {
-  using namespace std::chrono;
-  return duration_cast<microseconds>(
-    steady_clock::now().time_since_epoch()
-  ).count();
-}
-
+// 사용:
+//   fakecan_demo                      실시간, 무한 루프, tick마다 모니터 출력
+//   fakecan_demo --virtual            가상 시간 1시간 soak (CPU 속도로 진행)
+//   fakecan_demo --virtual --seconds N
+//   fakecan_demo ... --capture out.cap   버스 RX/TX 전부 기록 (can_replay로 재생/검증)
 
 static constexpr double DT_S = 0.01;
+static constexpr uint64_t DT_US = 10000;
+static constexpr uint64_t HB_PERIOD_US = 10000;  // 0x100 command 100Hz
+
+struct DemoOptions {
+  bool virtual_time = false;
+  double seconds = 0.0;      // 0 = 무한 (실시간 모드만)
+  std::string capture_path;
+};
+
+static bool parse_args(int argc, char** argv, DemoOptions& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--virtual") opt.virtual_time = true;
+    else if (a == "--seconds" && i + 1 < argc) opt.seconds = std::atof(argv[++i]);
+    else if (a == "--capture" && i + 1 < argc) opt.capture_path = argv[++i];
+    else return false;
+  }
+  if (opt.virtual_time && opt.seconds <= 0.0) opt.seconds = 3600.0;
+  return true;
+}
 
-int main() {
+static int run(IClock& clock, const DemoOptions& opt) {
   ControllerCore core;
   Plant plant;
   FakeCanBus bus(FakeCanBus::Config{
     .delay_us  = 2000,
     .jitter_us = 3000,
-    .drop_rate = 0.01
+    .drop_rate = 0.01,
+    .rx_overflow = OverflowPolicy::CountAndFlag
   });
-
+  CommsWatchdog comms(clock);
 
   Inputs in{};
   Outputs out{};
+  CanFrame rx_buf[256];
 
   // 초기 command 주입
   in.drive_enable = true;
@@ -36,42 +62,101 @@ int main() {
   in.battery_ok = true;
   in.target_velocity = 1.0;
 
-  bus.push_rx(encode_cmd(in));
-
-  static uint64_t last_cmd_us = 0;
+  // 가상 시간이면 writer를 기다려서라도 전부 기록 (실시간은 drop 카운트)
+  std::unique_ptr<CanCaptureWriter> capture;
+  if (!opt.capture_path.empty()) {
+    const CanFrame boot = encode_cmd(in);
+    capture = std::make_unique<CanCaptureWriter>(opt.capture_path, &boot,
+                                                 CanCaptureWriter::Config{opt.virtual_time});
+    if (!capture->is_open()) {
+      std::cerr << capture->error() << "\n";
+      return 1;
+    }
+    bus.set_tap(capture.get());
+  }
 
-  while (true) {
-    bus.poll(now_us());
+  bus.poll(clock);
+  bus.push_rx(encode_cmd(in));
 
-    // ---- RX ----
-    auto rx = bus.pop_rx();
-    if (rx) {
-      decode_cmd(*rx, in);
-      last_cmd_us = now_us();
+  const uint64_t t_start = clock.now_us();
+  const uint64_t t_end = t_start + static_cast<uint64_t>(opt.seconds * 1e6);
+  uint64_t next_tick = t_start;
+  uint64_t last_hb_us = t_start;
+  uint64_t ticks = 0;
+
+  const auto wall0 = std::chrono::steady_clock::now();
+
+  while (opt.seconds <= 0.0 || clock.now_us() < t_end) {
+    {
+      AllocTrapScope no_alloc;   // ALLOC_TRAP=1 빌드: RX~TX 구간 heap 할당 -> abort
+      bus.poll(clock);
+
+      // ---- RX ---- (도착한 프레임 전부, 최대 rx 큐 용량만큼)
+      const size_t n_rx = bus.drain_rx(rx_buf);
+      for (size_t i = 0; i < n_rx; ++i) decode_cmd(rx_buf[i], in);
+      if (n_rx) comms.kick();
+
+      in.comms_ok = comms.ok();
+      if (bus.overflow_dtc()) in.critical_dtc = true;   // 수신 프레임 유실 -> critical DTC
+
+      // heartbeat: 주기적으로 CMD 송신
+      if (clock.now_us() - last_hb_us >= HB_PERIOD_US) {
+        bus.push_rx(encode_cmd(in));
+        last_hb_us = clock.now_us();
+      }
+
+      // ---- Control ----
+      out = core.step(in, DT_S);
+      plant.step(out, in, DT_S);
+
+      // ---- TX ----
+      auto tx = encode_act(out);
+      bus.push_tx(tx);
+      CanFrame tx_buf[8];
+      while (bus.drain_tx(tx_buf)) {}   // 상대 node가 바로 소비했다고 가정
     }
 
-    if (auto rx = bus.pop_rx()) {
-        decode_cmd(*rx, in);
-        last_cmd_us = now_us();
-        }
-
-    in.comms_ok = (now_us() - last_cmd_us) <= 100000; // 100ms    
+    // ---- Monitor ---- (가상 시간이면 sim 10s마다)
+    ++ticks;
+    if (!opt.virtual_time || ticks % 1000 == 0) {
+      std::cout
+        << "vel=" << in.velocity
+        << " target=" << in.target_velocity
+        << " cmd=" << out.motor_cmd
+        << " state=" << state_name(static_cast<State>(core.debug().state))
+        << "\n";
+    }
 
-    // ---- Control ----
-    out = core.step(in, DT_S);
-    plant.step(out, in, DT_S);
+    next_tick += DT_US;
+    clock.sleep_until_us(next_tick);
+  }
 
-    // ---- TX ----
-    auto tx = encode_act(out);
-    bus.push_tx(tx);
+  const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+  const double sim_s = (clock.now_us() - t_start) / 1e6;
+  std::cout << "ticks=" << ticks
+            << " sim=" << sim_s << " s"
+            << " wall=" << wall_s << " s"
+            << " speedup=" << (wall_s > 0.0 ? sim_s / wall_s : 0.0) << "x\n";
+  if (capture) {
+    bus.set_tap(nullptr);
+    capture->stop();
+    std::cout << "capture: " << capture->records() << " frames -> " << opt.capture_path
+              << " (dropped " << capture->dropped() << ")\n";
+  }
+  return 0;
+}
 
-    // ---- Monitor ----
-    std::cout
-      << "vel=" << in.velocity
-      << " target=" << in.target_velocity
-      << " cmd=" << out.motor_cmd
-      << "\n";
+int main(int argc, char** argv) {
+  DemoOptions opt;
+  if (!parse_args(argc, argv, opt)) {
+    std::cerr << "usage: fakecan_demo [--virtual] [--seconds N] [--capture PATH]\n";
+    return 2;
+  }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  if (opt.virtual_time) {
+    VirtualClock clock;
+    return run(clock, opt);
   }
+  SteadyClock clock;
+  return run(clock, opt);
 }
@@ -1,6 +1,4 @@
 #include <iostream>
-#include <thread>
-#include <chrono>
 #include <cmath>
 
 #include <termios.h>
@@ -11,13 +9,8 @@
 #include "plant.hpp"                  // -Isim
 #include "drivers/fakecan_bus.hpp"    // -Isrc
 #include "drivers/fakecan_codec.hpp"  // -Isrc
-
-static uint64_t now_us() {
-  using namespace std::chrono;
-  return duration_cast<microseconds>(
-    steady_clock::now().time_since_epoch()
-  ).count();
-}
+#include "clock.hpp"                  // -Iinclude
+#include "comms_watchdog.hpp"
 
 
 static constexpr double DT_S = 0.01;
@@ -59,6 +52,7 @@ static double clamp(double v, double lo, double hi) {
 }
 
 int main() {
+  SteadyClock clock;   // 키보드 입력이라 실시간만
   ControllerCore core;
   Plant plant;
   FakeCanBus bus(FakeCanBus::Config{
@@ -92,10 +86,11 @@ int main() {
   bool running = true;
   bool ack_pulse = false;
 
-  static uint64_t last_cmd_us = 0;
+  CommsWatchdog comms(clock);
+  uint64_t next_tick = clock.now_us();
 
   while (running) {
-    bus.poll(now_us());
+    bus.poll(clock);
 
     // ----- 키 입력 처리: 상태 변경 -> CAN Rx 주입 -----
     int k = read_key_nonblock();
@@ -118,23 +113,18 @@ int main() {
       bus.push_rx(encode_cmd(in)); // “외부에서 CAN으로 명령이 들어왔다”를 주입
     }
 
-    // ----- RX: CAN -> Inputs 반영 -----
-    if (auto rx = bus.pop_rx()) {
-      decode_cmd(*rx, in);
-      last_cmd_us = now_us();
-    }
-
-    if (auto rx = bus.pop_rx()) {
-        decode_cmd(*rx, in);
-        last_cmd_us = now_us();
-    }
+    // ----- RX: CAN -> Inputs 반영 (도착한 프레임 전부) -----
+    CanFrame rx_buf[256];
+    const size_t n_rx = bus.drain_rx(rx_buf);
+    for (size_t i = 0; i < n_rx; ++i) decode_cmd(rx_buf[i], in);
+    if (n_rx) comms.kick();
 
-    in.comms_ok = (now_us() - last_cmd_us) <= 100000; // 100ms
+    in.comms_ok = comms.ok(); // 100ms
 
     static uint64_t last_hb_us = 0;
     const uint64_t HB_PERIOD_US = 100000; // 100ms = 10Hz
 
-    uint64_t now = now_us();
+    uint64_t now = clock.now_us();
 
     // heartbeat: 주기적으로 CMD 송신
     if (now - last_hb_us >= HB_PERIOD_US) {
@@ -148,6 +138,8 @@ int main() {
 
     // ----- TX: Outputs -> CAN -----
     bus.push_tx(encode_act(out));
+    CanFrame tx_buf[8];
+    while (bus.drain_tx(tx_buf)) {}   // 상대 node가 바로 소비했다고 가정
 
     // ACK pulse는 한 tick만 유지
     if (ack_pulse) {
@@ -172,7 +164,8 @@ int main() {
         << "\n";
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    next_tick += 10000;   // 10ms, 절대 시각 기준 (drift 없음)
+    clock.sleep_until_us(next_tick);
   }
 
   set_stdin_nonblocking_raw(false);
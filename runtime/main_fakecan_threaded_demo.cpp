@@ -0,0 +1,175 @@
+#include <atomic>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+#include "controller_core.hpp"
+#include "plant.hpp"
+#include "clock.hpp"
+#include "drivers/fakecan_bus.hpp"
+#include "drivers/fakecan_codec.hpp"
+#include "drivers/can_port.hpp"
+#include "drivers/socketcan_port.hpp"
+#include "can_io_thread.hpp"
+#include "comms_watchdog.hpp"
+#include "rt/alloc_trap.hpp"
+
+// =====================
+// FakeCAN 데모 (2 스레드)
+//   I/O thread    : FakeCanBus(또는 SocketCAN) 소유, 1ms 주기 RX decode / TX encode + 가상 VCU/모터 node
+//   control thread: 10ms 주기 InputFrame -> core.step -> plant.step -> OutputFrame, 모니터 출력
+//   둘 사이는 SpscRing (CanIoThread)
+//
+// 사용: fakecan_threaded_demo [--seconds N] [--io-period US] [--socketcan IF]
+//   N = 0 이면 무한 루프 (실시간만, 가상 시간 없음)
+//   --socketcan vcan0 : FakeCanBus 대신 SocketCAN (0x100은 밖에서, 예: cangen/cansend)
+// =====================
+
+static constexpr double DT_S = 0.01;
+static constexpr uint64_t DT_US = 10000;
+static constexpr uint64_t HB_PERIOD_US = 10000;  // 0x100 command 100Hz
+
+struct DemoOptions {
+  double seconds = 0.0;
+  uint64_t io_period_us = 1000;
+  std::string can_if;        // 비어 있으면 FakeCanBus
+};
+
+static bool parse_args(int argc, char** argv, DemoOptions& opt) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--seconds" && i + 1 < argc) opt.seconds = std::atof(argv[++i]);
+    else if (a == "--io-period" && i + 1 < argc) opt.io_period_us = std::strtoull(argv[++i], nullptr, 10);
+    else if (a == "--socketcan" && i + 1 < argc) opt.can_if = argv[++i];
+    else return false;
+  }
+  return opt.io_period_us > 0;
+}
+
+// control thread (main): io가 start된 뒤 호출, 끝나면 io.stop()
+static uint64_t run_control(CanIoThread<>& io, IClock& clock, const DemoOptions& opt,
+                            const std::atomic<bool>& bus_dtc) {
+  ControllerCore core;
+  Plant plant;
+  CommsWatchdog comms(clock);
+
+  Inputs in{};
+  in.comms_ok = true;
+  in.battery_ok = true;
+  Outputs out{};
+  InputFrame frame;
+
+  const uint64_t t_start = clock.now_us();
+  const uint64_t t_end = t_start + static_cast<uint64_t>(opt.seconds * 1e6);
+  uint64_t next_tick = t_start;
+  uint64_t ticks = 0;
+
+  while (opt.seconds <= 0.0 || clock.now_us() < t_end) {
+    {
+      AllocTrapScope no_alloc;   // ALLOC_TRAP=1 빌드: read~write 구간 heap 할당 -> abort
+      if (io.input().read(frame)) {
+        copy_cmd_fields(frame.in, in);
+        comms.kick();
+      }
+      in.comms_ok = comms.ok();
+      if (bus_dtc.load(std::memory_order_relaxed)) in.critical_dtc = true;
+
+      out = core.step(in, DT_S);
+      plant.step(out, in, DT_S);
+
+      io.output().write(OutputFrame{out, clock.now_us()});
+    }
+
+    // ---- Monitor ---- (느려져도 I/O thread의 CAN 수신에는 영향 없음)
+    ++ticks;
+    std::cout
+      << "vel=" << in.velocity
+      << " target=" << in.target_velocity
+      << " cmd=" << out.motor_cmd
+      << " state=" << state_name(static_cast<State>(core.debug().state))
+      << "\n";
+
+    next_tick += DT_US;
+    clock.sleep_until_us(next_tick);
+  }
+
+  io.stop();
+
+  const auto st = io.stats();
+  std::cout << "ticks=" << ticks
+            << " io_cycles=" << st.cycles
+            << " rx=" << st.rx_frames << " (cmd=" << st.rx_cmd << ", ring_drop=" << st.rx_ring_drops << ")"
+            << " tx=" << st.tx_frames << " (port_drop=" << st.tx_port_drops
+            << ", out_ring_drop=" << io.output_sink().dropped() << ")";
+  return ticks;
+}
+
+// SocketCAN: VCU/모터는 버스 밖의 실제 node (sim hook 없음)
+static int run_socketcan(IClock& clock, const DemoOptions& opt) {
+  SocketCanPort port(opt.can_if);
+  if (!port.is_open()) {
+    std::cerr << "socketcan: " << port.error() << "\n";
+    return 1;
+  }
+  CanIoThread<> io(port, clock, {opt.io_period_us});
+  const std::atomic<bool> no_dtc{false};
+
+  io.start();
+  run_control(io, clock, opt, no_dtc);
+  std::cout << " rx_err=" << port.rx_errors() << " tx_err=" << port.tx_errors()
+            << " hw_ts=" << (port.hw_timestamps() ? 1 : 0) << "\n";
+  return 0;
+}
+
+static int run_fakecan(IClock& clock, const DemoOptions& opt) {
+  // start 후에는 I/O thread만 bus를 만짐
+  FakeCanBus bus(FakeCanBus::Config{
+    .delay_us  = 2000,
+    .jitter_us = 3000,
+    .drop_rate = 0.01,
+    .rx_overflow = OverflowPolicy::CountAndFlag
+  });
+  FakeCanPort<FakeCanBus> port(bus);
+  CanIoThread<> io(port, clock, {opt.io_period_us});
+
+  Inputs vcu{};   // 가상 VCU가 보내는 command
+  vcu.drive_enable = true;
+  vcu.comms_ok = true;
+  vcu.battery_ok = true;
+  vcu.target_velocity = 1.0;
+
+  uint64_t last_hb_us = 0;
+  uint64_t motor_frames = 0;
+  std::atomic<bool> bus_dtc{false};   // 수신 프레임 유실 -> control thread의 critical DTC
+
+  io.set_sim_hook([&](uint64_t now_us) {
+    if (now_us - last_hb_us >= HB_PERIOD_US) {
+      CanFrame f = encode_cmd(vcu);
+      f.t_us = now_us;
+      bus.push_rx(f);
+      last_hb_us = now_us;
+    }
+    CanFrame tx_buf[16];   // 모터 node: 0x200을 바로 소비
+    while (size_t n = bus.drain_tx(tx_buf))
+      for (size_t i = 0; i < n; ++i) motor_frames += can_msg::Act::match(tx_buf[i]) ? 1 : 0;
+    if (bus.overflow_dtc()) bus_dtc.store(true, std::memory_order_relaxed);
+  });
+
+  io.start();
+  run_control(io, clock, opt, bus_dtc);
+  std::cout << " motor_rx=" << motor_frames
+            << " bus_overflow=" << bus.rx_overflows()
+            << "\n";
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  DemoOptions opt;
+  if (!parse_args(argc, argv, opt)) {
+    std::cerr << "usage: fakecan_threaded_demo [--seconds N] [--io-period US] [--socketcan IF]\n";
+    return 2;
+  }
+
+  SteadyClock clock;   // 두 스레드가 공유 (SteadyClock은 상태 없음)
+  return opt.can_if.empty() ? run_fakecan(clock, opt) : run_socketcan(clock, opt);
+}
@@ -2,6 +2,8 @@
 #include "../include/main_inputs_outputs.hpp"
 
 struct Plant {
+    static constexpr double STOP_EPS = 1e-4;   // |vel| < eps 면 정지
+
     // simple plant states (0~1)
     double lift_pos = 0.0;
     double dump_pos = 0.0;
@@ -9,5 +11,12 @@ struct Plant {
     // velocity simulation
     double vel = 0.0;
 
+    // 차량별 파라미터 (population run에서 바꿔 씀, PlantBatch와 같은 의미)
+    double max_accel = 2.0;   // motor_cmd = 1 일 때 가속
+    double drag = 1.2;        // 점성 감속 (1/s)
+
     void step(const Outputs& out, Inputs& in, double dt);
+
+    // velocity만 (Inputs 전체를 안 거칠 때), 새 vel 반환
+    double step(double motor_cmd, double dt);
 };
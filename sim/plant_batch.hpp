@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "plant.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PLANT_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// =====================
+// N대 Plant를 SoA로 묶어서 한 번에 step (population / robustness run)
+// - lane별 파라미터(max_accel/drag)와 상태(vel)는 배열, 입력은 motor_cmd 배열만
+//   (Inputs 전체를 거치지 않음, 결과는 vel[] 그대로)
+// - AVX2(4 lane) / SSE2(2 lane) / scalar 중 실행 시점에 선택 (PIDBatch와 같은 방식)
+// - 결과는 lane마다 같은 파라미터의 Plant::step과 bit 단위로 동일 (FMA 미사용)
+// =====================
+class PlantBatch {
+public:
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    // lane별 파라미터
+    std::vector<double> max_accel, drag;
+    // lane별 상태
+    std::vector<double> vel;
+
+    explicit PlantBatch(std::size_t n = 0, double a = Plant{}.max_accel, double d = Plant{}.drag)
+        : isa_(detect_isa()) {
+        resize(n, a, d);
+    }
+
+    // 새로 생긴 lane은 (a, d) 파라미터 + 정지 상태
+    void resize(std::size_t n, double a = Plant{}.max_accel, double d = Plant{}.drag) {
+        max_accel.resize(n, a);
+        drag.resize(n, d);
+        vel.resize(n, 0.0);
+    }
+
+    std::size_t size() const { return vel.size(); }
+
+    void set_params(std::size_t k, double a, double d) { max_accel[k] = a; drag[k] = d; }
+    void reset() { std::fill(vel.begin(), vel.end(), 0.0); }
+
+    static Isa detect_isa() {
+#if defined(PLANT_BATCH_X86)
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        return Isa::SSE2;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    Isa isa() const { return isa_; }
+    // 테스트/벤치에서 경로 강제 (지원 안 되는 ISA는 detect 결과로 내려감)
+    void set_isa(Isa isa) {
+        const Isa best = detect_isa();
+        isa_ = (static_cast<int>(isa) > static_cast<int>(best)) ? best : isa;
+    }
+
+    // motor_cmd: 길이 size() 배열, 결과는 vel[]
+    void step(const double* motor_cmd, double dt) {
+        const std::size_t n = size();
+        std::size_t k = 0;
+#if defined(PLANT_BATCH_X86)
+        if (isa_ == Isa::AVX2)      k = step_avx2_(motor_cmd, dt, n);
+        else if (isa_ == Isa::SSE2) k = step_sse2_(motor_cmd, dt, n);
+#endif
+        for (; k < n; ++k) vel[k] = step_one_(k, motor_cmd[k], dt);
+    }
+
+private:
+    // scalar 기준 구현 (Plant::step 그대로)
+    double step_one_(std::size_t k, double motor_cmd, double dt) {
+        const double u = motor_cmd ? motor_cmd : 0.0;
+        const double accel = u * max_accel[k] - drag[k] * vel[k];
+        double v = vel[k] + accel * dt;
+        if (std::abs(v) < Plant::STOP_EPS) v = 0.0;
+        return v;
+    }
+
+#if defined(PLANT_BATCH_X86)
+    // ---------- AVX2: 4 lane ----------
+    __attribute__((target("avx2")))
+    std::size_t step_avx2_(const double* motor_cmd, double dt, std::size_t n) {
+        const __m256d vdt = _mm256_set1_pd(dt);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d eps = _mm256_set1_pd(Plant::STOP_EPS);
+        const __m256d sign = _mm256_set1_pd(-0.0);
+
+        std::size_t k = 0;
+        for (; k + 4 <= n; k += 4) {
+            __m256d u = _mm256_loadu_pd(motor_cmd + k);
+            u = _mm256_andnot_pd(_mm256_cmp_pd(u, zero, _CMP_EQ_OQ), u);   // u ? u : 0.0 (-0.0 -> +0.0)
+            const __m256d v0 = _mm256_loadu_pd(&vel[k]);
+            const __m256d accel = _mm256_sub_pd(_mm256_mul_pd(u, _mm256_loadu_pd(&max_accel[k])),
+                                                _mm256_mul_pd(_mm256_loadu_pd(&drag[k]), v0));
+            const __m256d v1 = _mm256_add_pd(v0, _mm256_mul_pd(accel, vdt));
+            const __m256d stop = _mm256_cmp_pd(_mm256_andnot_pd(sign, v1), eps, _CMP_LT_OQ);
+            _mm256_storeu_pd(&vel[k], _mm256_andnot_pd(stop, v1));
+        }
+        return k;
+    }
+
+    // ---------- SSE2: 2 lane ----------
+    std::size_t step_sse2_(const double* motor_cmd, double dt, std::size_t n) {
+        const __m128d vdt = _mm_set1_pd(dt);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d eps = _mm_set1_pd(Plant::STOP_EPS);
+        const __m128d sign = _mm_set1_pd(-0.0);
+
+        std::size_t k = 0;
+        for (; k + 2 <= n; k += 2) {
+            __m128d u = _mm_loadu_pd(motor_cmd + k);
+            u = _mm_andnot_pd(_mm_cmpeq_pd(u, zero), u);
+            const __m128d v0 = _mm_loadu_pd(&vel[k]);
+            const __m128d accel = _mm_sub_pd(_mm_mul_pd(u, _mm_loadu_pd(&max_accel[k])),
+                                             _mm_mul_pd(_mm_loadu_pd(&drag[k]), v0));
+            const __m128d v1 = _mm_add_pd(v0, _mm_mul_pd(accel, vdt));
+            const __m128d stop = _mm_cmplt_pd(_mm_andnot_pd(sign, v1), eps);
+            _mm_storeu_pd(&vel[k], _mm_andnot_pd(stop, v1));
+        }
+        return k;
+    }
+#endif
+
+    Isa isa_ = Isa::Scalar;
+};
@@ -0,0 +1,131 @@
+#include "vehicle_plant.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double G = 9.81;
+
+// 적분 상태 (미분값도 같은 모양)
+struct State {
+    double force, vel, lift_flow, lift_pos, dump_flow, dump_pos;
+};
+
+inline State axpy(const State& x, double a, const State& d) {
+    return State{x.force + a * d.force, x.vel + a * d.vel,
+                 x.lift_flow + a * d.lift_flow, x.lift_pos + a * d.lift_pos,
+                 x.dump_flow + a * d.dump_flow, x.dump_pos + a * d.dump_pos};
+}
+
+// step() 1번 동안 고정인 값
+struct Coeffs {
+    double u;                  // slew 통과한 motor_cmd (substep 동안 고정)
+    double inv_motor_tau;      // 0 = 지연 없음 (force = u 고정)
+    double max_force, drag, grav_f, coul_f, inv_m;
+    double inv_valve_tau;      // 0 = 지연 없음 (flow = target 고정)
+    double lift_target, dump_target;
+    double lift_up, lift_down, dump_up, dump_down;
+};
+
+inline double drive_accel(const Coeffs& k, double force, double v) {
+    double net = force * k.max_force - k.drag * v - k.grav_f;
+    if (v > 0.0) net -= k.coul_f;
+    else if (v < 0.0) net += k.coul_f;
+    else if (std::abs(net) <= k.coul_f) net = 0.0;          // 정지 마찰이 버팀
+    else net -= (net > 0.0) ? k.coul_f : -k.coul_f;
+    return net * k.inv_m;
+}
+
+inline State deriv(const Coeffs& k, const State& x) {
+    return State{
+        (k.u - x.force) * k.inv_motor_tau,
+        drive_accel(k, x.force, x.vel),
+        (k.lift_target - x.lift_flow) * k.inv_valve_tau,
+        x.lift_flow * (x.lift_flow > 0.0 ? k.lift_up : k.lift_down),
+        (k.dump_target - x.dump_flow) * k.inv_valve_tau,
+        x.dump_flow * (x.dump_flow > 0.0 ? k.dump_up : k.dump_down),
+    };
+}
+
+} // namespace
+
+void VehiclePlant::step(const Outputs& out, Inputs& in, double dt) {
+    const VehiclePlantParams& p = params;
+    const int n = std::max(1, p.substeps);
+    const double h = dt / n;
+    const double m = p.mass_kg + p.load_kg;
+
+    Coeffs k;
+    k.u = u_slew;
+    k.inv_motor_tau = p.motor_tau_s > 0.0 ? 1.0 / p.motor_tau_s : 0.0;
+    k.max_force = p.max_force_n;
+    k.drag = p.drag_ns_per_m;
+    if (!cached_ || p.slope_rad != cached_slope_ || m != cached_m_ || p.coulomb_coeff != cached_coeff_) {
+        grav_f_ = p.slope_rad != 0.0 ? m * G * std::sin(p.slope_rad) : 0.0;
+        coul_f_ = p.coulomb_coeff != 0.0 ? p.coulomb_coeff * m * G * std::cos(p.slope_rad) : 0.0;
+        cached_slope_ = p.slope_rad;
+        cached_m_ = m;
+        cached_coeff_ = p.coulomb_coeff;
+        cached_ = true;
+    }
+    k.grav_f = grav_f_;
+    k.coul_f = coul_f_;
+    k.inv_m = 1.0 / m;
+    k.inv_valve_tau = p.valve_tau_s > 0.0 ? 1.0 / p.valve_tau_s : 0.0;
+    k.lift_target = out.lift_cmd ? 1.0 : -1.0;   // cmd 없으면 자중으로 내려옴
+    k.dump_target = out.dump_cmd ? 1.0 : -1.0;
+    k.lift_up = p.lift_raise_per_s;
+    k.lift_down = p.lift_lower_per_s;
+    k.dump_up = p.dump_raise_per_s;
+    k.dump_down = p.dump_lower_per_s;
+
+    const double u_cmd = out.motor_cmd ? out.motor_cmd : 0.0;
+    const double max_du = p.cmd_rate_per_s * h;
+
+    State x{force, vel, lift_flow, lift_pos, dump_flow, dump_pos};
+    for (int i = 0; i < n; ++i) {
+        // rate limit (substep마다)
+        if (p.cmd_rate_per_s > 0.0) k.u += std::clamp(u_cmd - k.u, -max_du, max_du);
+        else k.u = u_cmd;
+        if (k.inv_motor_tau == 0.0) x.force = k.u;
+        if (k.inv_valve_tau == 0.0) { x.lift_flow = k.lift_target; x.dump_flow = k.dump_target; }
+
+        const double v_prev = x.vel;
+        if (p.integrator == PlantIntegrator::Euler) {
+            const State d = deriv(k, x);
+            x = axpy(x, h, d);
+        } else {
+            const State k1 = deriv(k, x);
+            const State k2 = deriv(k, axpy(x, 0.5 * h, k1));
+            const State k3 = deriv(k, axpy(x, 0.5 * h, k2));
+            const State k4 = deriv(k, axpy(x, h, k3));
+            const double w = h / 6.0;
+            x.force     += w * (k1.force + 2.0 * k2.force + 2.0 * k3.force + k4.force);
+            x.vel       += w * (k1.vel + 2.0 * k2.vel + 2.0 * k3.vel + k4.vel);
+            x.lift_flow += w * (k1.lift_flow + 2.0 * k2.lift_flow + 2.0 * k3.lift_flow + k4.lift_flow);
+            x.lift_pos  += w * (k1.lift_pos + 2.0 * k2.lift_pos + 2.0 * k3.lift_pos + k4.lift_pos);
+            x.dump_flow += w * (k1.dump_flow + 2.0 * k2.dump_flow + 2.0 * k3.dump_flow + k4.dump_flow);
+            x.dump_pos  += w * (k1.dump_pos + 2.0 * k2.dump_pos + 2.0 * k3.dump_pos + k4.dump_pos);
+        }
+
+        // 0을 지나쳤는데 정지 마찰이 버티면 그 자리에 멈춤 (부호 떨림 방지)
+        if (k.coul_f > 0.0 && ((v_prev > 0.0 && x.vel < 0.0) || (v_prev < 0.0 && x.vel > 0.0)) &&
+            std::abs(x.force * k.max_force - k.grav_f) <= k.coul_f)
+            x.vel = 0.0;
+        if (std::abs(x.vel) < p.stop_eps) x.vel = 0.0;
+        x.lift_pos = std::clamp(x.lift_pos, 0.0, 1.0);
+        x.dump_pos = std::clamp(x.dump_pos, 0.0, 1.0);
+    }
+
+    force = x.force;
+    vel = x.vel;
+    lift_flow = x.lift_flow;
+    lift_pos = x.lift_pos;
+    dump_flow = x.dump_flow;
+    dump_pos = x.dump_pos;
+    u_slew = k.u;
+
+    in.velocity = vel;
+    if (p.lift_raise_per_s > 0.0) in.lift_complete = lift_pos >= p.complete_pos;
+    if (p.dump_raise_per_s > 0.0) in.dump_complete = dump_pos >= p.complete_pos;
+}
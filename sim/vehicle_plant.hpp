@@ -0,0 +1,83 @@
+#pragma once
+#include "../include/main_inputs_outputs.hpp"
+
+// =====================
+// VehiclePlant: Plant보다 실제 차량에 가까운 plant (drive + lift/dump 유압)
+// - drive: motor_cmd -> slew(rate limit) -> 모터 1차 지연(tau) -> 구동력
+//          가속 = (구동력 - 점성 drag - 경사 중력 - Coulomb 마찰) / (차량 + 적재 질량)
+//          정지 중엔 정지 마찰이 구동력을 넘을 때까지 안 움직임
+// - lift/dump: 밸브 1차 지연 -> 실린더 속도(올림/내림 따로) -> 위치 0~1
+//              cmd 없으면 자중으로 내려옴, complete_pos 이상이면 *_complete
+// - 적분기: Euler / RK4, control tick당 substeps번 (slew도 substep마다)
+// - VehiclePlantParams::legacy()는 Plant와 bit 단위로 같은 결과 (Euler, substep 1, 지연/마찰 없음)
+// =====================
+
+enum class PlantIntegrator { Euler, RK4 };
+
+struct VehiclePlantParams {
+    // --- drive ---
+    double mass_kg = 1200.0;
+    double load_kg = 0.0;
+    double max_force_n = 2400.0;       // motor_cmd = 1 일 때 (빈 차 2 m/s^2)
+    double drag_ns_per_m = 1440.0;     // 점성 drag (빈 차 1.2 /s)
+    double coulomb_coeff = 0.015;      // 구름 저항 계수 (x 수직항력)
+    double slope_rad = 0.0;            // 오르막 +
+    double motor_tau_s = 0.05;         // 0 = 지연 없음
+    double cmd_rate_per_s = 5.0;       // motor_cmd slew, 0 = 제한 없음
+    double stop_eps = 1e-4;            // |vel| < eps 면 0 (Plant와 같음)
+
+    // --- lift / dump 유압 (속도 0 = 모델 끔, 위치 고정 / *_complete 안 씀) ---
+    double valve_tau_s = 0.1;
+    double lift_raise_per_s = 0.25;    // 완전 상승 4 s
+    double lift_lower_per_s = 0.33;
+    double dump_raise_per_s = 0.5;
+    double dump_lower_per_s = 0.5;
+    double complete_pos = 0.98;
+
+    // --- 적분 ---
+    PlantIntegrator integrator = PlantIntegrator::RK4;
+    int substeps = 2;
+
+    // 기존 Plant (max_accel 2.0, drag 1.2, forward Euler)와 같은 결과
+    static VehiclePlantParams legacy() {
+        VehiclePlantParams p;
+        p.mass_kg = 1.0;
+        p.load_kg = 0.0;
+        p.max_force_n = 2.0;
+        p.drag_ns_per_m = 1.2;
+        p.coulomb_coeff = 0.0;
+        p.slope_rad = 0.0;
+        p.motor_tau_s = 0.0;
+        p.cmd_rate_per_s = 0.0;
+        p.lift_raise_per_s = p.lift_lower_per_s = 0.0;
+        p.dump_raise_per_s = p.dump_lower_per_s = 0.0;
+        p.integrator = PlantIntegrator::Euler;
+        p.substeps = 1;
+        return p;
+    }
+};
+
+struct VehiclePlant {
+    VehiclePlant() = default;
+    explicit VehiclePlant(const VehiclePlantParams& p) : params(p) {}
+
+    // Plant::step과 같은 시그니처 (run_drive_case 등에 그대로)
+    void step(const Outputs& out, Inputs& in, double dt);
+
+    VehiclePlantParams params{};
+
+    // state (Plant와 같은 이름: vel / lift_pos / dump_pos)
+    double vel = 0.0;
+    double lift_pos = 0.0;
+    double dump_pos = 0.0;
+    double force = 0.0;       // 모터 출력 (motor_cmd 단위)
+    double lift_flow = 0.0;   // 밸브 개도 (-1 내림 ~ +1 올림)
+    double dump_flow = 0.0;
+    double u_slew = 0.0;      // rate limit 통과한 motor_cmd
+
+private:
+    // 경사 중력 / Coulomb 마찰력 (sin/cos는 slope/질량/계수가 바뀔 때만)
+    double cached_slope_ = 0.0, cached_m_ = 0.0, cached_coeff_ = 0.0;
+    double grav_f_ = 0.0, coul_f_ = 0.0;
+    bool cached_ = false;
+};
@@ -21,6 +21,12 @@ void ControllerCore::reset() {
     dbg_ = ControllerDebug{};
 }
 
+void ControllerCore::set_drive_gains(double kp, double ki, double kd) {
+    drive_pid_.kp = kp;
+    drive_pid_.ki = ki;
+    drive_pid_.kd = kd;
+}
+
 FaultReason ControllerCore::pick_fault_reason(const Inputs& in, bool comms_ok_filtered) {
     if (in.estop_button)            return FaultReason::ESTOP;
     if (in.critical_dtc)            return FaultReason::CRITICAL_DTC;
@@ -36,6 +42,9 @@ FaultReason ControllerCore::pick_fault_reason(const Inputs& in, bool comms_ok_fi
 }
 
 Outputs ControllerCore::step(const Inputs& in, double dt) {
+    CTRL_PROF_START(t_total);
+    CTRL_PROF_START(t_phase);
+
     const bool stopped = (std::abs(in.velocity) < 0.01);
 
     // 기본 출력 안전(중립)
@@ -66,6 +75,8 @@ Outputs ControllerCore::step(const Inputs& in, double dt) {
         }
     }
 
+    CTRL_PROF_LAP(t_phase, StepPhase::CommsFilter);
+
     // 0) E-STOP 최우선 상태
     if (in.estop_button) {
         state_ = State::E_STOP;
@@ -75,6 +86,7 @@ Outputs ControllerCore::step(const Inputs& in, double dt) {
         dbg_.fault_latched = fault_latched_;
         dbg_.comms_ok_filtered = comms_ok_filtered_;
         dbg_.fault_code = out_.fault_code;
+        CTRL_PROF_STOP(t_total, StepPhase::Total);
         return out_;
     }
 
@@ -92,6 +104,8 @@ Outputs ControllerCore::step(const Inputs& in, double dt) {
         state_ = State::FAULT;
     }
 
+    CTRL_PROF_LAP(t_phase, StepPhase::FaultPick);
+
     // 4) 상태 처리
     switch (state_) {
         case State::IDLE:    handle_idle(in, stopped);        break;
@@ -102,6 +116,8 @@ Outputs ControllerCore::step(const Inputs& in, double dt) {
         case State::E_STOP:  handle_estop(in);                break;
     }
 
+    CTRL_PROF_LAP(t_phase, StepPhase::StateHandler);
+
     // debug 갱신
     dbg_.state = (int)state_;
     dbg_.fault_latched = fault_latched_;
@@ -110,6 +126,8 @@ Outputs ControllerCore::step(const Inputs& in, double dt) {
 
     dbg_.pid_dbg = drive_pid_.dbg;
 
+    CTRL_PROF_STOP(t_phase, StepPhase::DebugSnapshot);
+    CTRL_PROF_STOP(t_total, StepPhase::Total);
     return out_;
 }
 
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include "../include/main_inputs_outputs.hpp"
 #include "../include/pid.hpp"
+#include "instrumentation/step_profiler.hpp"
 
 // main.cpp에 있던 enum들을 코어로 옮김
 enum class State {
@@ -25,6 +26,34 @@ enum class FaultReason : std::uint16_t {
     DUMP_SENSOR_ERR  = 80
 };
 
+// 로그/모니터 출력용 이름
+inline const char* state_name(State s) {
+    switch (s) {
+        case State::IDLE:    return "IDLE";
+        case State::DRIVE:   return "DRIVE";
+        case State::LIFT_OP: return "LIFT_OP";
+        case State::DUMP_OP: return "DUMP_OP";
+        case State::FAULT:   return "FAULT";
+        case State::E_STOP:  return "E_STOP";
+        default:             return "UNKNOWN";
+    }
+}
+
+inline const char* fault_name(FaultReason r) {
+    switch (r) {
+        case FaultReason::NONE:            return "NONE";
+        case FaultReason::ESTOP:           return "E_STOP";
+        case FaultReason::CRITICAL_DTC:    return "CRITICAL_DTC";
+        case FaultReason::CAN_TIMEOUT:     return "CAN_TIMEOUT";
+        case FaultReason::COMMS_LOST:      return "COMMS_LOST";
+        case FaultReason::LIFT_TIMEOUT:    return "LIFT_TIMEOUT";
+        case FaultReason::LIFT_SENSOR_ERR: return "LIFT_SENSOR_ERR";
+        case FaultReason::DUMP_TIMEOUT:    return "DUMP_TIMEOUT";
+        case FaultReason::DUMP_SENSOR_ERR: return "DUMP_SENSOR_ERR";
+        default:                           return "UNKNOWN_FAULT";
+    }
+}
+
 struct ControllerDebug {
     int state = 0;
     bool fault_latched = false;
@@ -45,7 +74,27 @@ public:
 
     void reset();
 
+    // drive PID 게인 변경 (gain sweep / 튜닝용, reset()해도 유지)
+    void set_drive_gains(double kp, double ki, double kd);
+
+    // drive PID 기본 게인 (ControllerFleet도 같은 값을 사용)
+    static constexpr double DRIVE_KP = 1.9;
+    static constexpr double DRIVE_KI = 2.5;
+    static constexpr double DRIVE_KD = 0.0;
+
+    static constexpr int COMMS_FAIL_TIMEOUT_MS   = 50;   // 50ms 이상 끊김이면 확정
+    static constexpr int COMMS_RECOVER_STABLE_MS = 100;  // 100ms 이상 안정이면 복구 인정
+
+#if defined(CONTROLLER_PROFILE)
+    // step 구간별 latency 히스토그램 (다른 스레드에서 읽어도 됨)
+    const StepProfiler& profiler() const { return profiler_; }
+    void reset_profiler() { profiler_.reset(); }
+#endif
+
 private:
+    // fault 우선순위 로직 공유 (SoA 버전)
+    friend class ControllerFleet;
+
     // ----- fault 우선순위 선택 -----
     static FaultReason pick_fault_reason(const Inputs& in, bool comms_ok_filtered);
 
@@ -68,7 +117,7 @@ private:
     Outputs out_{};
 
     // PID (main.cpp 기본값 그대로)
-    PID drive_pid_{1.9, 2.5, 0.0};
+    PID drive_pid_{DRIVE_KP, DRIVE_KI, DRIVE_KD};
 
     // complete 후 버튼 release 전 재진입 금지
     bool lift_inhibit_until_release_ = false;
@@ -79,9 +128,10 @@ private:
     int  comms_ok_ms_   = 0;
     bool comms_ok_filtered_ = true;
 
-    static constexpr int COMMS_FAIL_TIMEOUT_MS   = 50;   // 50ms 이상 끊김이면 확정
-    static constexpr int COMMS_RECOVER_STABLE_MS = 100;  // 100ms 이상 안정이면 복구 인정
-
     // debug snapshot
     ControllerDebug dbg_{};
+
+#if defined(CONTROLLER_PROFILE)
+    StepProfiler profiler_;
+#endif
 };
@@ -0,0 +1,209 @@
+#include "controller_fleet.hpp"
+#include <cmath>
+
+ControllerFleet::ControllerFleet(std::size_t n) { resize(n); }
+
+void ControllerFleet::resize(std::size_t n) {
+    const std::size_t old = size();
+
+    state_.resize(n);
+    fault_latched_.resize(n);
+    latched_reason_.resize(n);
+    fault_code_.resize(n);
+    lift_inhibit_.resize(n);
+    dump_inhibit_.resize(n);
+    comms_fail_ms_.resize(n);
+    comms_ok_ms_.resize(n);
+    comms_ok_filtered_.resize(n);
+    pid_.resize(n, ControllerCore::DRIVE_KP, ControllerCore::DRIVE_KI, ControllerCore::DRIVE_KD);
+    pid_run_.resize(n);
+    pid_target_.resize(n);
+    pid_current_.resize(n);
+    pid_u_.resize(n);
+
+    for (std::size_t i = old; i < n; ++i) reset(i);
+}
+
+void ControllerFleet::reset() {
+    for (std::size_t i = 0; i < size(); ++i) reset(i);
+}
+
+void ControllerFleet::reset(std::size_t i) {
+    state_[i] = State::IDLE;
+    fault_latched_[i] = 0;
+    latched_reason_[i] = FaultReason::NONE;
+    fault_code_[i] = 0;
+
+    lift_inhibit_[i] = 0;
+    dump_inhibit_[i] = 0;
+
+    comms_fail_ms_[i] = 0;
+    comms_ok_ms_[i] = 0;
+    comms_ok_filtered_[i] = 1;
+
+    pid_.reset(i);
+    pid_run_[i] = 0;
+}
+
+ControllerDebug ControllerFleet::debug(std::size_t i) const {
+    // ControllerCore::dbg_.pid_dbg는 E-STOP tick에서 갱신되지 않지만,
+    // 그 tick에는 PID도 건드리지 않으므로 항상 PID의 dbg와 같다.
+    ControllerDebug d{};
+    d.state = (int)state_[i];
+    d.fault_latched = fault_latched_[i] != 0;
+    d.comms_ok_filtered = comms_ok_filtered_[i] != 0;
+    d.fault_code = fault_code_[i];
+    d.pid_dbg = pid_.debug(i);
+    return d;
+}
+
+bool ControllerFleet::step(const std::vector<Inputs>& in, std::vector<Outputs>& out, double dt) {
+    if (in.size() != size()) return false;
+    out.resize(size());
+    step(in.data(), out.data(), dt);
+    return true;
+}
+
+void ControllerFleet::step(const Inputs* in, Outputs* out, double dt) {
+    const int dt_ms = (dt > 0) ? (int)std::lround(dt * 1000.0) : 10;
+
+    comms_filter_(in, dt_ms);
+    run_states_(in, out);
+    run_pid_(out, dt);
+}
+
+// =========================
+// 1) inhibit 해제 + COMMS_LOST 필터 (슬롯 간 분기 없음)
+// =========================
+void ControllerFleet::comms_filter_(const Inputs* in, int dt_ms) {
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!in[i].lift_request) lift_inhibit_[i] = 0;
+        if (!in[i].dump_request) dump_inhibit_[i] = 0;
+
+        if (!in[i].comms_ok) {
+            comms_fail_ms_[i] += dt_ms;
+            comms_ok_ms_[i] = 0;
+            if (comms_fail_ms_[i] >= ControllerCore::COMMS_FAIL_TIMEOUT_MS) comms_ok_filtered_[i] = 0;
+        } else {
+            comms_ok_ms_[i] += dt_ms;
+            comms_fail_ms_[i] = 0;
+            if (comms_ok_ms_[i] >= ControllerCore::COMMS_RECOVER_STABLE_MS) comms_ok_filtered_[i] = 1;
+        }
+    }
+}
+
+// =========================
+// 2) E-STOP / fault latch / 상태 핸들러 (ControllerCore::handle_* 와 동일)
+//    DRIVE 유지 슬롯은 pid_run_에 표시 + target/current만 모아두고 PID는 3)에서 일괄 계산
+// =========================
+void ControllerFleet::run_states_(const Inputs* in, Outputs* out) {
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const Inputs& x = in[i];
+        Outputs& o = out[i];
+
+        o = Outputs{};
+        pid_run_[i] = 0;
+
+        const bool stopped = (std::abs(x.velocity) < 0.01);
+        const bool comms_ok = comms_ok_filtered_[i] != 0;
+
+        // 0) E-STOP 최우선 상태
+        if (x.estop_button) {
+            state_[i] = State::E_STOP;
+            o.fault_code = static_cast<std::uint16_t>(FaultReason::ESTOP);
+            fault_code_[i] = o.fault_code;
+            continue;
+        }
+
+        // 1) fault 감지 + 2) 래치 세트
+        const FaultReason current = ControllerCore::pick_fault_reason(x, comms_ok);
+        if (current != FaultReason::NONE && !fault_latched_[i]) {
+            fault_latched_[i] = 1;
+            latched_reason_[i] = current;
+        }
+
+        // 3) fault_latched면 FAULT로 강제
+        if (fault_latched_[i]) state_[i] = State::FAULT;
+
+        // 4) 상태 처리
+        switch (state_[i]) {
+            case State::IDLE:
+                if (x.drive_enable && x.battery_ok && comms_ok) {
+                    state_[i] = State::DRIVE;
+                } else if (!lift_inhibit_[i] && x.lift_request && !x.drive_enable && stopped) {
+                    state_[i] = State::LIFT_OP;
+                    o.lift_cmd = true;
+                } else if (!dump_inhibit_[i] && x.dump_request && !x.drive_enable && stopped) {
+                    state_[i] = State::DUMP_OP;
+                    o.dump_cmd = true;
+                }
+                break;
+
+            case State::DRIVE:
+                if (!x.drive_enable || !x.battery_ok || !comms_ok) {
+                    pid_.reset(i);
+                    state_[i] = State::IDLE;
+                } else {
+                    o.drive_cmd = true;
+                    pid_run_[i] = 1;
+                    pid_target_[i] = x.target_velocity;
+                    pid_current_[i] = x.velocity;
+                }
+                break;
+
+            case State::LIFT_OP:
+                if (x.drive_enable) { state_[i] = State::IDLE; break; }
+                o.lift_cmd = x.lift_request && stopped;
+                if (x.lift_complete) {
+                    lift_inhibit_[i] = 1;
+                    state_[i] = State::IDLE;
+                } else if (!x.lift_request) {
+                    state_[i] = State::IDLE;
+                }
+                break;
+
+            case State::DUMP_OP:
+                if (x.drive_enable) { state_[i] = State::IDLE; break; }
+                o.dump_cmd = x.dump_request && stopped;
+                if (x.dump_complete) {
+                    dump_inhibit_[i] = 1;
+                    state_[i] = State::IDLE;
+                } else if (!x.dump_request) {
+                    state_[i] = State::IDLE;
+                }
+                break;
+
+            case State::FAULT:
+                o = Outputs{};
+                o.fault_code = static_cast<std::uint16_t>(latched_reason_[i]);
+                if (x.no_active_fault && x.operator_ack) {
+                    fault_latched_[i] = 0;
+                    latched_reason_[i] = FaultReason::NONE;
+                    state_[i] = State::IDLE;
+                }
+                break;
+
+            case State::E_STOP:
+                o = Outputs{};
+                o.fault_code = static_cast<std::uint16_t>(FaultReason::ESTOP);
+                if (!x.estop_button && x.operator_ack) state_[i] = State::IDLE;
+                break;
+        }
+
+        fault_code_[i] = o.fault_code;
+    }
+}
+
+// =========================
+// 3) drive PID: PIDBatch로 DRIVE 슬롯만 일괄 계산 (PID::compute와 bit 단위 동일)
+// =========================
+void ControllerFleet::run_pid_(Outputs* out, double dt) {
+    pid_.compute(pid_target_.data(), pid_current_.data(), dt, pid_u_.data(), pid_run_.data());
+
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (pid_run_[i]) out[i].motor_cmd = pid_u_[i];
+    }
+}
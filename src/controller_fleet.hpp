@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "controller_core.hpp"
+#include "../include/pid_batch.hpp"
+
+// =====================
+// N대 ControllerCore를 SoA(structure-of-arrays)로 묶어서 한 번에 step
+// - 결과(Outputs / ControllerDebug)는 N개의 ControllerCore와 bit 단위로 동일
+// - fleet 시뮬레이터에서 차량 수천 대를 한 tick에 처리하기 위한 용도
+// =====================
+class ControllerFleet {
+public:
+    explicit ControllerFleet(std::size_t n = 0);
+
+    // 크기 변경 (새로 생긴 슬롯은 reset 상태)
+    void resize(std::size_t n);
+    std::size_t size() const { return state_.size(); }
+
+    void reset();
+    void reset(std::size_t i);
+
+    // 슬롯별 drive PID 게인 (ControllerCore::set_drive_gains와 동일, reset()해도 유지)
+    void set_drive_gains(std::size_t i, double kp, double ki, double kd) { pid_.set_gains(i, kp, ki, kd); }
+
+    // in[0..N) -> out[0..N), 10ms 주기에서 1회 호출 (dt는 초 단위)
+    void step(const Inputs* in, Outputs* out, double dt);
+    // in.size() != size()면 아무것도 안 하고 false (out/상태 그대로)
+    bool step(const std::vector<Inputs>& in, std::vector<Outputs>& out, double dt);
+
+    ControllerDebug debug(std::size_t i) const;
+
+private:
+    // ----- tick 단계별 처리 -----
+    void comms_filter_(const Inputs* in, int dt_ms);
+    void run_states_(const Inputs* in, Outputs* out);
+    void run_pid_(Outputs* out, double dt);
+
+private:
+    // core state
+    std::vector<State>         state_;
+    std::vector<std::uint8_t>  fault_latched_;
+    std::vector<FaultReason>   latched_reason_;
+    std::vector<std::uint16_t> fault_code_;      // 마지막 step의 out.fault_code
+
+    std::vector<std::uint8_t>  lift_inhibit_;
+    std::vector<std::uint8_t>  dump_inhibit_;
+
+    // comms filter 내부 상태
+    std::vector<int>           comms_fail_ms_;
+    std::vector<int>           comms_ok_ms_;
+    std::vector<std::uint8_t>  comms_ok_filtered_;
+
+    // drive PID (SoA + SIMD)
+    PIDBatch pid_;
+
+    // 이번 tick에 PID를 돌릴 슬롯 (DRIVE 유지) + PIDBatch 입출력
+    std::vector<std::uint8_t>  pid_run_;
+    std::vector<double>        pid_target_;
+    std::vector<double>        pid_current_;
+    std::vector<double>        pid_u_;
+};
@@ -0,0 +1,204 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "can_frame.hpp"
+#include "can_tap.hpp"
+#include "../../include/util/spsc_ring.hpp"
+
+// =====================
+// CAN capture (.cap): 버스에서 오간 RX/TX 프레임 전부 + 버스 시간(t_us)
+// - 파일: [CanCaptureFileHeader][CanCaptureRecord x N] (little-endian, 그대로 dump)
+// - CanCaptureWriter: ICanTap 구현. 버스 스레드는 SPSC ring에 24B 복사만,
+//   writer 스레드가 모아서 fwrite (LogSink와 같은 구조)
+//   lossless=false(실시간): ring이 차면 drop 카운트 / true(가상 시간 soak, test): 빌 때까지 대기
+// - boot_cmd: controller 시작 시 command 상태 (첫 0x100 도착 전 Inputs), replay가 같은 상태에서 시작
+// =====================
+
+struct CanCaptureRecord {
+    std::uint64_t t_us = 0;
+    std::uint32_t id = 0;
+    std::uint8_t  dir = 0;        // CanDir
+    std::uint8_t  dlc = 0;
+    std::uint8_t  reserved[2]{};
+    std::uint8_t  data[8]{};
+};
+static_assert(std::is_trivially_copyable<CanCaptureRecord>::value, "CanCaptureRecord must be POD");
+static_assert(sizeof(CanCaptureRecord) == 24, "CanCaptureRecord layout changed");
+
+struct CanCaptureFileHeader {
+    char magic[8] = {'C', 'T', 'L', 'C', 'A', 'N', '1', '\0'};
+    std::uint32_t version = 1;
+    std::uint32_t record_size = sizeof(CanCaptureRecord);
+    CanCaptureRecord boot_cmd{};  // id == 0 이면 없음
+    std::uint8_t reserved[8]{};
+};
+static_assert(sizeof(CanCaptureFileHeader) == 48, "CanCaptureFileHeader layout changed");
+
+inline CanCaptureRecord make_capture_record(CanDir dir, const CanFrame& f, std::uint64_t t_us) {
+    CanCaptureRecord r;
+    r.t_us = t_us;
+    r.id = f.id;
+    r.dir = static_cast<std::uint8_t>(dir);
+    r.dlc = f.dlc;
+    std::memcpy(r.data, f.data, sizeof(r.data));
+    return r;
+}
+
+inline CanFrame capture_frame(const CanCaptureRecord& r) {
+    CanFrame f;
+    f.id = r.id;
+    f.dlc = r.dlc;
+    std::memcpy(f.data, r.data, sizeof(f.data));
+    f.t_us = r.t_us;
+    return f;
+}
+
+class CanCaptureWriter final : public ICanTap {
+public:
+    static constexpr std::size_t RING_SIZE = 8192;    // 100Hz x 수 프레임 기준 수십 초 여유
+    static constexpr std::size_t WRITE_BATCH = 512;
+
+    struct Config {
+        bool lossless = false;
+    };
+
+    CanCaptureWriter(const std::string& path, const CanFrame* boot_cmd = nullptr)
+        : CanCaptureWriter(path, boot_cmd, Config{}) {}
+    CanCaptureWriter(const std::string& path, const CanFrame* boot_cmd, Config cfg) : cfg_(cfg) {
+        f_ = std::fopen(path.c_str(), "wb");
+        if (!f_) {
+            error_ = "cannot open " + path;
+            return;
+        }
+        CanCaptureFileHeader h;
+        if (boot_cmd) h.boot_cmd = make_capture_record(CanDir::Rx, *boot_cmd, 0);
+        if (std::fwrite(&h, sizeof(h), 1, f_) != 1) {
+            error_ = "cannot write header: " + path;
+            std::fclose(f_);
+            f_ = nullptr;
+            return;
+        }
+        ring_ = std::make_unique<SpscRing<CanCaptureRecord, RING_SIZE>>();
+        writer_ = std::thread([this] { writer_loop_(); });
+    }
+
+    ~CanCaptureWriter() override { stop(); }
+
+    CanCaptureWriter(const CanCaptureWriter&) = delete;
+    CanCaptureWriter& operator=(const CanCaptureWriter&) = delete;
+
+    // 버스 스레드: 복사 1회 + atomic store
+    void on_frame(CanDir dir, const CanFrame& f, std::uint64_t t_us) override {
+        if (!ring_) return;
+        const CanCaptureRecord r = make_capture_record(dir, f, t_us);
+        while (!ring_->try_push(r)) {
+            if (!cfg_.lossless) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // 남은 레코드 다 쓰고 파일 닫음 (이후 on_frame은 ring에만 쌓임)
+    void stop() {
+        if (writer_.joinable()) {
+            stop_.store(true, std::memory_order_release);
+            writer_.join();
+        }
+        if (f_) {
+            std::fclose(f_);
+            f_ = nullptr;
+        }
+    }
+
+    bool is_open() const { return ring_ != nullptr; }
+    const std::string& error() const { return error_; }
+    std::uint64_t records() const { return records_.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::size_t drain_once_() {
+        std::size_t n = 0, total = 0;
+        while (true) {
+            while (n < WRITE_BATCH && ring_->try_pop(batch_[n])) ++n;
+            if (n == 0) break;
+            std::fwrite(batch_, sizeof(CanCaptureRecord), n, f_);
+            records_.fetch_add(n, std::memory_order_relaxed);
+            total += n;
+            n = 0;
+        }
+        return total;
+    }
+
+    void writer_loop_() {
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (drain_once_() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        drain_once_();
+        std::fflush(f_);
+    }
+
+    Config cfg_;
+    std::FILE* f_ = nullptr;
+    std::string error_;
+
+    std::unique_ptr<SpscRing<CanCaptureRecord, RING_SIZE>> ring_;
+    CanCaptureRecord batch_[WRITE_BATCH];   // writer thread 전용
+
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> records_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::thread writer_;
+};
+
+// 파일 전체를 메모리로 (replay용, 시간순 그대로)
+class CanCaptureReader {
+public:
+    explicit CanCaptureReader(const std::string& path) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            error_ = "cannot open " + path;
+            return;
+        }
+        const CanCaptureFileHeader expect;
+        if (std::fread(&header_, sizeof(header_), 1, f) != 1 ||
+            std::memcmp(header_.magic, expect.magic, sizeof(expect.magic)) != 0 ||
+            header_.version != expect.version || header_.record_size != sizeof(CanCaptureRecord)) {
+            error_ = "not a CAN capture (or version mismatch): " + path;
+            std::fclose(f);
+            return;
+        }
+        std::fseek(f, 0, SEEK_END);
+        const long bytes = std::ftell(f) - static_cast<long>(sizeof(header_));
+        std::fseek(f, sizeof(header_), SEEK_SET);
+        records_.resize(bytes > 0 ? static_cast<std::size_t>(bytes) / sizeof(CanCaptureRecord) : 0);
+        records_.resize(std::fread(records_.data(), sizeof(CanCaptureRecord), records_.size(), f));
+        std::fclose(f);
+        open_ = true;
+    }
+
+    bool is_open() const { return open_; }
+    const std::string& error() const { return error_; }
+
+    const std::vector<CanCaptureRecord>& records() const { return records_; }
+    bool has_boot_cmd() const { return header_.boot_cmd.id != 0; }
+    CanFrame boot_cmd() const { return capture_frame(header_.boot_cmd); }
+
+private:
+    bool open_ = false;
+    std::string error_;
+    CanCaptureFileHeader header_{};
+    std::vector<CanCaptureRecord> records_;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "can_frame.hpp"
+
+// =====================
+// CAN port: raw frame 송수신 (I/O 스레드 한 개만 사용)
+// - receive/send 모두 non-blocking, burst 단위
+// - FakeCanPort: FakeCanBus adapter (poll + drain_rx / push_tx_batch)
+// - SocketCanPort (socketcan_port.hpp): 실제 버스 / vcan
+// =====================
+class ICanPort {
+public:
+    virtual ~ICanPort() = default;
+
+    // 도착한 프레임을 out[0..max)에 복사, 개수 반환
+    virtual std::size_t receive(CanFrame* out, std::size_t max, std::uint64_t now_us) = 0;
+
+    // 실제로 나간 개수 반환
+    virtual std::size_t send(const CanFrame* frames, std::size_t n, std::uint64_t now_us) = 0;
+};
+
+// BusT: BasicFakeCanBus<...> (port가 bus를 소유하지 않음, I/O 스레드 밖에서 만지지 말 것)
+template <class BusT>
+class FakeCanPort final : public ICanPort {
+public:
+    explicit FakeCanPort(BusT& bus) : bus_(bus) {}
+
+    std::size_t receive(CanFrame* out, std::size_t max, std::uint64_t now_us) override {
+        bus_.poll(now_us);
+        return bus_.drain_rx(out, max);
+    }
+
+    std::size_t send(const CanFrame* frames, std::size_t n, std::uint64_t) override {
+        return bus_.push_tx_batch(frames, n);
+    }
+
+    BusT& bus() { return bus_; }
+
+private:
+    BusT& bus_;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../../include/clock.hpp"
+#include "../../include/io/input_source.hpp"
+#include "can_capture.hpp"
+#include "fakecan_codec.hpp"
+
+// =====================
+// CanReplayInputSource: capture(.cap)를 control tick 단위로 다시 재생
+// - tick 경계 = 기록된 TX 0x200 (controller는 tick마다 0x200을 1개 보냄)
+//   read() 1번 = 다음 0x200까지의 RX를 decode_cmd로 반영 + 그 0x200을 expected_act()로
+// - t_us = 그 tick의 버스 시간 (기록값)
+// - pace == nullptr: CPU 속도로 / pace 주면 기록 간격대로 sleep_until (실시간 재생)
+// - 기록이 끝나면(남은 0x200 없음) false
+// =====================
+class CanReplayInputSource final : public IInputSource {
+public:
+    CanReplayInputSource(const CanCaptureRecord* recs, std::size_t n, const CanFrame* boot_cmd,
+                         IClock* pace = nullptr)
+        : recs_(recs), n_(n), pace_(pace) {
+        if (boot_cmd) decode_cmd(*boot_cmd, frame_.in);
+    }
+
+    explicit CanReplayInputSource(const CanCaptureReader& cap, IClock* pace = nullptr)
+        : CanReplayInputSource(cap.records().data(), cap.records().size(), nullptr, pace) {
+        if (cap.has_boot_cmd()) decode_cmd(cap.boot_cmd(), frame_.in);
+    }
+
+    bool read(InputFrame& out) override {
+        tick_rx_ = 0;
+        while (pos_ < n_) {
+            const CanCaptureRecord& r = recs_[pos_++];
+            if (r.dir == static_cast<std::uint8_t>(CanDir::Rx)) {
+                decode_cmd(capture_frame(r), frame_.in);   // 0x100 외는 무시
+                ++tick_rx_;
+            } else if (r.id == can_msg::Act::id) {
+                expected_act_ = capture_frame(r);
+                return emit_(r.t_us, out);
+            }
+        }
+        return false;
+    }
+
+    // 이번 tick에 도착했던 RX 프레임 수 (id 무관, comms watchdog kick 기준)
+    std::size_t tick_rx() const { return tick_rx_; }
+    // 이번 tick에 controller가 실제로 보냈던 0x200
+    const CanFrame& expected_act() const { return expected_act_; }
+    std::uint64_t ticks() const { return ticks_; }
+
+private:
+    bool emit_(std::uint64_t t_us, InputFrame& out) {
+        if (pace_) {
+            if (ticks_ == 0) {
+                pace_t0_ = pace_->now_us();
+                rec_t0_ = t_us;
+            }
+            pace_->sleep_until_us(pace_t0_ + (t_us - rec_t0_));
+        }
+        ++ticks_;
+        frame_.t_us = t_us;
+        frame_.valid = true;
+        out = frame_;
+        return true;
+    }
+
+    const CanCaptureRecord* recs_;
+    std::size_t n_;
+    std::size_t pos_ = 0;
+    IClock* pace_;
+    std::uint64_t pace_t0_ = 0;
+    std::uint64_t rec_t0_ = 0;
+
+    InputFrame frame_{};
+    CanFrame expected_act_{};
+    std::size_t tick_rx_ = 0;
+    std::uint64_t ticks_ = 0;
+};
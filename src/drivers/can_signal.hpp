@@ -0,0 +1,180 @@
+#pragma once
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+#include "can_frame.hpp"
+
+// =====================
+// compile-time CAN signal layout
+// - Signal<start, len, signed, scale, offset, order> 하나가 DBC signal 한 줄
+//   (start/len: DBC bit 번호, scale/offset: std::ratio -> phys = raw * scale + offset)
+// - get/set은 frame.data를 직접 읽고 씀 (복사 없음), 모든 파라미터가 상수라
+//   -O2에서 shift/mask만 남음
+// - Intel(little endian): start = LSB 위치
+//   Motorola(big endian): start = MSB 위치 (DBC sawtooth 번호)
+// =====================
+
+enum class ByteOrder : std::uint8_t { Intel, Motorola };
+
+template <unsigned Start, unsigned Len, bool Signed = false,
+          class Scale = std::ratio<1>, class Offset = std::ratio<0>,
+          ByteOrder Order = ByteOrder::Intel>
+struct Signal {
+    static_assert(Len >= 1 && Len <= 64, "signal length 1..64");
+    static_assert(Start < 64, "classic CAN payload is 64 bit");
+
+    static constexpr unsigned start = Start;
+    static constexpr unsigned len = Len;
+    static constexpr bool is_signed = Signed;
+    static constexpr ByteOrder order = Order;
+    static constexpr bool unit_scale = (Scale::num == Scale::den) && (Offset::num == 0);
+
+    static constexpr std::uint64_t mask = (Len == 64) ? ~0ull : ((1ull << Len) - 1);
+    static constexpr std::int64_t raw_min = Signed ? -(std::int64_t)(mask >> 1) - 1 : 0;
+    static constexpr std::int64_t raw_max = Signed ? (std::int64_t)(mask >> 1) : (std::int64_t)(mask >> (Len == 64));
+
+    // 신호가 차지하는 마지막 byte + 1 (dlc 검증용)
+    static constexpr unsigned end_byte() {
+        if (Order == ByteOrder::Intel) return (Start + Len - 1) / 8 + 1;
+        unsigned pos = Start;
+        for (unsigned i = 1; i < Len; ++i) pos = next_motorola_(pos);
+        return pos / 8 + 1;
+    }
+
+    // ---------- raw ----------
+    // Intel: 걸친 byte들을 little endian word로 모아 shift/mask 한 번
+    //        (컴파일러가 byte load를 하나의 load로 합침)
+    static constexpr std::uint64_t get_raw(const std::uint8_t* d) {
+        if constexpr (Order == ByteOrder::Intel && Start % 8 + Len <= 64) {
+            constexpr unsigned first = Start / 8, last = (Start + Len - 1) / 8;
+            std::uint64_t w = 0;
+            for (unsigned b = first; b <= last; ++b)
+                w |= static_cast<std::uint64_t>(d[b]) << (8 * (b - first));
+            return (w >> (Start % 8)) & mask;
+        } else if constexpr (Order == ByteOrder::Intel) {
+            std::uint64_t raw = 0;
+            for (unsigned i = 0; i < Len; ++i)
+                raw |= static_cast<std::uint64_t>((d[(Start + i) / 8] >> ((Start + i) % 8)) & 1u) << i;
+            return raw;
+        } else {
+            std::uint64_t raw = 0;
+            unsigned pos = Start;
+            for (unsigned i = 0; i < Len; ++i) {
+                raw = (raw << 1) | ((d[pos / 8] >> (pos % 8)) & 1u);
+                pos = next_motorola_(pos);
+            }
+            return raw;
+        }
+    }
+
+    static constexpr void set_raw(std::uint8_t* d, std::uint64_t raw) {
+        raw &= mask;
+        if constexpr (Order == ByteOrder::Intel && Start % 8 + Len <= 64) {
+            constexpr unsigned first = Start / 8, last = (Start + Len - 1) / 8;
+            constexpr std::uint64_t m = mask << (Start % 8);
+            std::uint64_t w = 0;
+            for (unsigned b = first; b <= last; ++b)
+                w |= static_cast<std::uint64_t>(d[b]) << (8 * (b - first));
+            w = (w & ~m) | (raw << (Start % 8));
+            for (unsigned b = first; b <= last; ++b)
+                d[b] = static_cast<std::uint8_t>(w >> (8 * (b - first)));
+        } else if constexpr (Order == ByteOrder::Intel) {
+            for (unsigned i = 0; i < Len; ++i) {
+                const unsigned pos = Start + i;
+                const unsigned b = static_cast<unsigned>(raw >> i) & 1u;
+                d[pos / 8] = static_cast<std::uint8_t>((d[pos / 8] & ~(1u << (pos % 8))) | (b << (pos % 8)));
+            }
+        } else {
+            unsigned pos = Start;
+            for (unsigned i = 0; i < Len; ++i) {
+                const unsigned b = static_cast<unsigned>(raw >> (Len - 1 - i)) & 1u;
+                d[pos / 8] = static_cast<std::uint8_t>((d[pos / 8] & ~(1u << (pos % 8))) | (b << (pos % 8)));
+                pos = next_motorola_(pos);
+            }
+        }
+    }
+
+    // signed면 부호 확장
+    static constexpr std::int64_t get_int(const std::uint8_t* d) {
+        const std::uint64_t raw = get_raw(d);
+        if constexpr (Signed && Len < 64)
+            return static_cast<std::int64_t>(raw << (64 - Len)) >> (64 - Len);   // movsx 한 번
+        else
+            return static_cast<std::int64_t>(raw);
+    }
+
+    // ---------- physical ----------
+    // decode: raw * num / den + offset (scale 1/1000 이면 raw / 1000.0 과 bit 동일)
+    // 1배 곱/0 더하기는 컴파일 타임에 제거
+    static constexpr double get(const std::uint8_t* d) {
+        double v = static_cast<double>(get_int(d));
+        if constexpr (Scale::num != 1) v *= static_cast<double>(Scale::num);
+        if constexpr (Scale::den != 1) v /= static_cast<double>(Scale::den);
+        if constexpr (Offset::num != 0) v += static_cast<double>(Offset::num) / Offset::den;
+        return v;
+    }
+
+    // encode: (phys - offset) * den / num, 0 방향 절삭 후 raw 범위로 saturate
+    static constexpr void set(std::uint8_t* d, double phys) {
+        double r = phys;
+        if constexpr (Offset::num != 0) r -= static_cast<double>(Offset::num) / Offset::den;
+        if constexpr (Scale::den != 1) r *= static_cast<double>(Scale::den);
+        if constexpr (Scale::num != 1) r /= static_cast<double>(Scale::num);
+        std::int64_t raw;
+        if (!(r >= static_cast<double>(raw_min))) raw = raw_min;   // NaN 포함
+        else if (r >= static_cast<double>(raw_max)) raw = raw_max;
+        else raw = static_cast<std::int64_t>(r);
+        set_raw(d, static_cast<std::uint64_t>(raw));
+    }
+
+    // 1 bit flag
+    static constexpr bool get_bool(const std::uint8_t* d) { return get_raw(d) != 0; }
+    static constexpr void set_bool(std::uint8_t* d, bool v) { set_raw(d, v ? 1u : 0u); }
+
+    // CanFrame 편의 함수
+    static constexpr double get(const CanFrame& f) { return get(f.data); }
+    static constexpr void set(CanFrame& f, double phys) { set(f.data, phys); }
+
+private:
+    // Motorola: byte 안에서 MSB->LSB로 내려가다 byte 경계면 다음 byte의 bit7
+    static constexpr unsigned next_motorola_(unsigned pos) {
+        return (pos % 8 == 0) ? pos + 15 : pos - 1;
+    }
+};
+
+// struct field <-> signal (field 타입으로 선택: bool=flag, 정수+scale 1=raw, 그 외=physical)
+// dbc2hpp가 생성하는 codec이 사용
+template <class Sig, class T>
+constexpr void can_load(T& field, const std::uint8_t* d) {
+    if constexpr (std::is_same_v<T, bool>) field = Sig::get_bool(d);
+    else if constexpr (std::is_integral_v<T> && Sig::unit_scale) field = static_cast<T>(Sig::get_int(d));
+    else field = static_cast<T>(Sig::get(d));
+}
+
+template <class Sig, class T>
+constexpr void can_store(std::uint8_t* d, const T& field) {
+    if constexpr (std::is_same_v<T, bool>) Sig::set_bool(d, field);
+    else if constexpr (std::is_integral_v<T> && Sig::unit_scale) Sig::set_raw(d, static_cast<std::uint64_t>(field));
+    else Sig::set(d, static_cast<double>(field));
+}
+
+// 메시지 base: id/dlc, 파생 struct에서 signal을 using으로 선언하고
+// static_assert(fits<...>()) 로 dlc 안에 들어가는지 컴파일 타임 검사
+template <std::uint32_t Id, std::uint8_t Dlc>
+struct CanMessage {
+    static constexpr std::uint32_t id = Id;
+    static constexpr std::uint8_t dlc = Dlc;
+    static_assert(Dlc <= 8, "classic CAN dlc <= 8");
+
+    template <class... Sigs>
+    static constexpr bool fits() { return ((Sigs::end_byte() <= Dlc) && ...); }
+
+    static constexpr bool match(const CanFrame& f) { return f.id == Id; }
+
+    static CanFrame make() {
+        CanFrame f;
+        f.id = Id;
+        f.dlc = Dlc;
+        return f;
+    }
+};
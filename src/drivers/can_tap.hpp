@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include "can_frame.hpp"
+
+// =====================
+// 버스 계층에서 오가는 프레임을 엿보는 hook (capture 등)
+// - Rx: controller 쪽으로 "도착"한 프레임 (FakeCanBus::poll에서 rx 큐에 들어간 순간)
+// - Tx: controller가 보낸 프레임 (push_tx로 tx 큐에 들어간 순간)
+// - t_us: 버스 시간 (마지막 poll 시각)
+// - 버스와 같은 스레드에서 불림 -> 구현은 복사 정도만 (IO/할당 금지)
+// =====================
+enum class CanDir : std::uint8_t { Rx = 0, Tx = 1 };
+
+class ICanTap {
+public:
+    virtual ~ICanTap() = default;
+    virtual void on_frame(CanDir dir, const CanFrame& f, std::uint64_t t_us) = 0;
+};
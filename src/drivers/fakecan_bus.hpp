@@ -1,75 +1,160 @@
 #pragma once
-#include <deque>
 #include <optional>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <random>
 #include <algorithm>
 #include "can_frame.hpp"
-
-class FakeCanBus {
+#include "can_tap.hpp"
+#include "../../include/clock.hpp"
+#include "../../include/util/static_ring.hpp"
+
+// =====================
+// FakeCanBus: 지연/지터/드롭이 있는 가상 CAN (단일 스레드)
+// - tx/rx/pending 큐 용량은 컴파일 타임 (StaticRing + 고정 배열 heap)
+//   -> 생성 후 heap 할당 없음 (RT 빌드: mlock + malloc 금지)
+// - 큐가 가득 차면 Config의 OverflowPolicy 적용
+//   pending은 도착 순서 heap이라 DropOldest 없이 항상 새 프레임을 버림
+//   (CountAndFlag면 flag도 세움)
+// - CountAndFlag로 버려진 프레임이 있으면 overflow_dtc() == true
+// - set_tap(tap): rx 도착 / tx 큐잉 프레임을 tap에 넘김 (기본 nullptr, 분기 1개 비용)
+// =====================
+
+template <size_t RxN = 256, size_t TxN = 256, size_t PendingN = 1024>
+class BasicFakeCanBus {
 public:
   struct Config {
     uint64_t delay_us  = 0;       // 기본 지연
     uint64_t jitter_us = 0;       // 0~jitter_us 추가
     double   drop_rate = 0.0;     // 0.0~1.0
+    uint64_t seed      = 0x5EEDCA4Eu;  // 지터/드롭 RNG seed (같은 seed면 같은 결과)
+
+    // 큐가 가득 찼을 때 (rx는 최신 명령 우선)
+    OverflowPolicy rx_overflow      = OverflowPolicy::DropOldest;
+    OverflowPolicy tx_overflow      = OverflowPolicy::DropNewest;
+    OverflowPolicy pending_overflow = OverflowPolicy::DropNewest;
   };
 
-  explicit FakeCanBus(Config cfg = {}) : cfg_(cfg), rng_(std::random_device{}()) {}
+  static constexpr size_t rx_capacity = RxN;
+  static constexpr size_t tx_capacity = TxN;
+  static constexpr size_t pending_capacity = PendingN;
+
+  BasicFakeCanBus() : BasicFakeCanBus(Config{}) {}
+  explicit BasicFakeCanBus(Config cfg)
+    : cfg_(cfg), tx_(cfg.tx_overflow), rx_(cfg.rx_overflow), rng_(cfg.seed) {}
+
+  // seed는 바뀌지 않음 (재현성 유지), 바꾸려면 reseed()
+  void set_config(const Config& cfg) {
+    const uint64_t seed = cfg_.seed;
+    cfg_ = cfg;
+    cfg_.seed = seed;
+    tx_.set_policy(cfg.tx_overflow);
+    rx_.set_policy(cfg.rx_overflow);
+  }
+  void reseed(uint64_t seed) { cfg_.seed = seed; rng_.seed(seed); }
 
-  void set_config(const Config& cfg) { cfg_ = cfg; }
+  // capture 등 (소유하지 않음, nullptr = 해제)
+  void set_tap(ICanTap* tap) { tap_ = tap; }
+
+  // TX는 즉시 큐잉(원하면 TX도 pending 처리 가능), 버려졌으면 false
+  bool push_tx(const CanFrame& f) {
+    if (!tx_.push(f)) return false;
+    if (tap_) tap_->on_frame(CanDir::Tx, f, now_us_);
+    return true;
+  }
 
-  // TX는 즉시 큐잉(원하면 TX도 pending 처리 가능)
-  void push_tx(const CanFrame& f) { tx_.push_back(f); }
+  // burst 송신: 들어간 개수 반환 (나머지는 정책대로 처리)
+  size_t push_tx_batch(const CanFrame* frames, size_t n) {
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) k += push_tx(frames[i]) ? 1 : 0;
+    return k;
+  }
 
   // RX는 "도착 예정"으로 pending에 넣음 (지연/지터/드롭 적용)
   void push_rx(const CanFrame& f) {
     if (should_drop_()) return;
+    if (pending_size_ == PendingN) {
+      ++pending_overflows_;
+      if (cfg_.pending_overflow == OverflowPolicy::CountAndFlag) pending_flag_ = true;
+      return;
+    }
 
     CanFrame g = f;
     const uint64_t extra = (cfg_.jitter_us > 0) ? (rand_u64_(0, cfg_.jitter_us)) : 0;
     g.t_us = f.t_us; // 원본 timestamp 유지(원하면 now로 overwrite 가능)
 
     const uint64_t deliver_us = now_us_ + cfg_.delay_us + extra;
-    pending_rx_.push_back({deliver_us, g});
+    pending_[pending_size_++] = Pending{deliver_us, seq_++, g};
+    std::push_heap(pending_.begin(), pending_.begin() + pending_size_, DeliversLater{});
   }
 
   // 시간을 진행시키고, 도착 시간이 된 pending을 rx_로 이동
+  // heap이라 프레임당 O(log n), 같은 도착 시간은 push 순서(FIFO)
   void poll(uint64_t now_us) {
     now_us_ = now_us;
 
-    // pending 중 deliver_us <= now_us 인 것들을 rx로 이동
-    // pending_rx_가 작으니 단순 순회(나중에 정렬/힙 가능)
-    auto it = pending_rx_.begin();
-    while (it != pending_rx_.end()) {
-      if (it->deliver_us <= now_us_) {
-        rx_.push_back(it->frame);
-        it = pending_rx_.erase(it);
-      } else {
-        ++it;
-      }
+    while (pending_size_ > 0 && pending_[0].deliver_us <= now_us_) {
+      std::pop_heap(pending_.begin(), pending_.begin() + pending_size_, DeliversLater{});
+      --pending_size_;
+      const CanFrame& f = pending_[pending_size_].frame;
+      if (rx_.push(f) && tap_) tap_->on_frame(CanDir::Rx, f, now_us_);
     }
   }
 
+  void poll(const IClock& clock) { poll(clock.now_us()); }
+
+  size_t pending_rx_size() const { return pending_size_; }
+  size_t rx_size() const { return rx_.size(); }
+  size_t tx_size() const { return tx_.size(); }
+
+  // 큐가 가득 차서 버린(덮어쓴) 프레임 수 (pending/rx 합산, tx)
+  uint64_t rx_overflows() const { return pending_overflows_ + rx_.overflows(); }
+  uint64_t tx_overflows() const { return tx_.overflows(); }
+
+  // CountAndFlag 큐에서 overflow 발생 (clear 전까지 유지)
+  bool overflow_dtc() const { return pending_flag_ || rx_.overflow_flag() || tx_.overflow_flag(); }
+  void clear_overflow_dtc() {
+    pending_flag_ = false;
+    rx_.clear_overflow_flag();
+    tx_.clear_overflow_flag();
+  }
+
   std::optional<CanFrame> pop_tx() {
-    if (tx_.empty()) return std::nullopt;
-    CanFrame f = tx_.front();
-    tx_.pop_front();
+    CanFrame f;
+    if (!tx_.pop(f)) return std::nullopt;
     return f;
   }
 
   std::optional<CanFrame> pop_rx() {
-    if (rx_.empty()) return std::nullopt;
-    CanFrame f = rx_.front();
-    rx_.pop_front();
+    CanFrame f;
+    if (!rx_.pop(f)) return std::nullopt;
     return f;
   }
 
+  // burst 수신: 도착한 프레임을 out[0..max)에 순서대로 복사, 개수 반환
+  // 한 tick에 rx 큐 전체를 비우려면 max >= rx_capacity
+  size_t drain_rx(CanFrame* out, size_t max) { return rx_.drain(out, max); }
+  size_t drain_tx(CanFrame* out, size_t max) { return tx_.drain(out, max); }
+
+  template <size_t N> size_t drain_rx(CanFrame (&out)[N]) { return drain_rx(out, N); }
+  template <size_t N> size_t drain_tx(CanFrame (&out)[N]) { return drain_tx(out, N); }
+
 private:
   struct Pending {
     uint64_t deliver_us;
+    uint64_t seq;       // 같은 deliver_us면 먼저 push된 것부터
     CanFrame frame;
   };
 
+  // std::*_heap은 max-heap -> "나중에 나갈 것"이 작은 쪽
+  struct DeliversLater {
+    bool operator()(const Pending& a, const Pending& b) const {
+      if (a.deliver_us != b.deliver_us) return a.deliver_us > b.deliver_us;
+      return a.seq > b.seq;
+    }
+  };
+
   bool should_drop_() {
     if (cfg_.drop_rate <= 0.0) return false;
     std::uniform_real_distribution<double> dist(0.0, 1.0);
@@ -83,10 +168,18 @@ private:
 
   Config cfg_;
   uint64_t now_us_ = 0;
+  ICanTap* tap_ = nullptr;
 
-  std::deque<CanFrame> tx_;
-  std::deque<CanFrame> rx_;
-  std::deque<Pending>  pending_rx_;
+  StaticRing<CanFrame, TxN> tx_;
+  StaticRing<CanFrame, RxN> rx_;
 
-  std::mt19937 rng_;
+  std::array<Pending, PendingN> pending_{};
+  size_t pending_size_ = 0;
+  uint64_t seq_ = 0;
+  uint64_t pending_overflows_ = 0;
+  bool pending_flag_ = false;
+
+  std::mt19937_64 rng_;
 };
+
+using FakeCanBus = BasicFakeCanBus<>;
@@ -1,52 +1,39 @@
 #pragma once
 #include "can_frame.hpp"
 #include "../include/main_inputs_outputs.hpp"
-#include <cstring>
+#include "vehicle_dbc.hpp"   // gen/ (can/vehicle.dbc)
 
-// ---------- Encode ------------
-inline CanFrame encode_cmd(const Inputs& in) {
-    CanFrame f;
-    f.id = 0x100;
-    f.dlc = 4;
-
-    int16_t vel = static_cast<int16_t>(in.target_velocity * 1000);
-
-    f.data[0] = vel & 0xFF;
-    f.data[1] = (vel >> 8) & 0xFF;
-    f.data[2] = 
-        (in.drive_enable ? 1 : 0) |
-        (in.estop_button ? 2 : 0) |
-        (in.operator_ack ? 4 : 0);
-    f.data[3] =
-        (in.comms_ok ? 1 : 0) |
-        (in.battery_ok ? 2 : 0);
-
-    return f;
-}
+// =====================
+// 메시지 layout = can/vehicle.dbc (make가 gen/vehicle_dbc.hpp로 생성, -Igen 필요)
+// - id / dlc / signal 위치와 scale은 DBC에만 있음 (DBC 수정 -> 모든 binary에 반영)
+// - 여기는 runtime이 쓰는 이름(can_msg::Cmd/Act/Diag, encode_*/decode_*)만 붙임
+// =====================
+namespace can_msg {
 
-inline CanFrame encode_act(const Outputs& out) {
-    CanFrame f;
-    f.id = 0x200;
-    f.dlc = 2;
+using Cmd  = vehicle_dbc::VCU_Cmd;     // 0x100 command (VCU -> controller)
+using Act  = vehicle_dbc::CTRL_Act;    // 0x200 actuator (controller -> motor)
+using Diag = vehicle_dbc::CTRL_Diag;   // 0x300 diag/DTC (controller -> 진단 tool)
 
-    int16_t cmd = static_cast<int16_t>(out.motor_cmd * 1000);
-    f.data[0] = cmd & 0xFF;
-    f.data[1] = (cmd >> 8) & 0xFF;
+} // namespace can_msg
 
-    return f;
-}
+// ---------- Encode ------------
+inline CanFrame encode_cmd(const Inputs& in) { return can_msg::Cmd::encode(in); }
+inline CanFrame encode_act(const Outputs& out) { return can_msg::Act::encode(out); }
+inline CanFrame encode_diag(const Outputs& out) { return can_msg::Diag::encode(out); }
 
 // ---------- Decode ------------
-inline void decode_cmd(const CanFrame f, Inputs& in) {
-    if (f.id != 0x100) return;
+// id가 다르면 무시 (frame에 없는 field는 그대로)
+inline void decode_cmd(const CanFrame& f, Inputs& in) {
+    if (can_msg::Cmd::match(f)) can_msg::Cmd::decode(f, in);
+}
 
-    int16_t vel = f.data[0] | (f.data[1] << 8);
-    in.target_velocity = vel / 1000.0;
+// 0x100이 싣는 필드만 from -> to (다른 스레드에서 decode한 Inputs를 합칠 때)
+inline void copy_cmd_fields(const Inputs& from, Inputs& to) { can_msg::Cmd::copy_fields(from, to); }
 
-    in.drive_enable = f.data[2] & 1;
-    in.estop_button = f.data[2] & 2;
-    in.operator_ack = f.data[2] & 4;
+inline void decode_act(const CanFrame& f, Outputs& out) {
+    if (can_msg::Act::match(f)) can_msg::Act::decode(f, out);
+}
 
-    in.comms_ok = f.data[3] & 1;
-    in.battery_ok = f.data[3] & 2;
-}
\ No newline at end of file
+inline void decode_diag(const CanFrame& f, Outputs& out) {
+    if (can_msg::Diag::match(f)) can_msg::Diag::decode(f, out);
+}
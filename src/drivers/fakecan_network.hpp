@@ -0,0 +1,205 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <queue>
+#include <vector>
+#include "can_frame.hpp"
+
+// =====================
+// 여러 ECU(node)가 붙는 공유 FakeCAN 버스
+// - bitrate(125k~1M)에 맞춘 bit-time 단위 프레임 길이 (stuff bit 최악/없음 선택)
+// - 버스가 비면 대기 중 프레임 중 가장 낮은 ID가 arbitration 승리
+//   (node마다 우선순위 mailbox가 있다고 가정 -> node 내부 priority inversion 없음)
+// - 전송 완료 시점에 송신 node를 제외한 모든 node의 RX로 전달
+// - ID별 큐잉/전체 지연, 버스 사용률 통계
+// 시간 단위: API는 us (FakeCanBus와 동일), 내부는 ns
+// =====================
+class FakeCanNetwork {
+public:
+  struct Config {
+    uint32_t bitrate = 500000;            // bit/s
+    bool worst_case_stuffing = true;      // false면 stuff bit 0개
+  };
+
+  using NodeId = size_t;
+
+  struct IdStats {
+    uint64_t frames = 0;
+    double   sum_queue_us = 0.0;          // 요청 -> arbitration 승리
+    double   max_queue_us = 0.0;
+    double   sum_latency_us = 0.0;        // 요청 -> 전송 완료 (수신측 도착)
+    double   max_latency_us = 0.0;
+
+    double mean_queue_us() const   { return frames ? sum_queue_us / frames : 0.0; }
+    double mean_latency_us() const { return frames ? sum_latency_us / frames : 0.0; }
+  };
+
+  FakeCanNetwork() : FakeCanNetwork(Config{}) {}
+  explicit FakeCanNetwork(Config cfg) : cfg_(cfg) {}
+
+  NodeId attach() {
+    rx_.emplace_back();
+    return rx_.size() - 1;
+  }
+
+  size_t node_count() const { return rx_.size(); }
+
+  // node가 t_us 시점에 TX 요청 (현재 버스 시간보다 과거면 현재 시간으로)
+  void send(NodeId node, const CanFrame& f, uint64_t t_us) {
+    const uint64_t req_ns = std::max<uint64_t>(t_us * 1000, now_ns_);
+    waiting_.push(Request{req_ns, seq_++, node, f});
+  }
+
+  // 버스 시간을 now_us까지 진행 (arbitration + 전송 + 전달)
+  void run_until(uint64_t now_us) {
+    const uint64_t until_ns = now_us * 1000;
+
+    while (true) {
+      // 전송 중인 프레임 완료 처리
+      if (in_flight_) {
+        if (in_flight_->end_ns > until_ns) break;
+        deliver_(*in_flight_);
+        in_flight_.reset();
+      }
+
+      // 다음 arbitration 시점: 버스가 비는 시간 이후 가장 이른 요청
+      // (until 이후 요청은 ready로 올리지 않음: 다음 호출에서 더 낮은 ID가 끼어들 수 있음)
+      uint64_t t = std::max(bus_free_ns_, now_ns_);
+      if (t > until_ns) break;
+      promote_(t);
+      if (ready_.empty()) {
+        if (waiting_.empty()) break;
+        t = waiting_.top().req_ns;
+        if (t > until_ns) break;
+        promote_(t);
+      }
+
+      // lowest ID wins
+      const Request r = ready_.top();
+      ready_.pop();
+
+      const uint64_t dur = frame_time_ns(r.frame);
+      in_flight_ = InFlight{r, t, t + dur};
+      bus_free_ns_ = t + dur;
+      busy_ns_ += dur;
+      now_ns_ = t;
+    }
+
+    now_ns_ = std::max(now_ns_, until_ns);
+  }
+
+  std::optional<CanFrame> receive(NodeId node) {
+    auto& q = rx_[node];
+    if (q.empty()) return std::nullopt;
+    CanFrame f = q.front();
+    q.pop_front();
+    return f;
+  }
+
+  // ----- 통계 -----
+  const std::map<uint32_t, IdStats>& id_stats() const { return stats_; }
+
+  // reset_stats() 이후 구간의 버스 점유율 (0~1)
+  double utilization() const {
+    const uint64_t span = now_ns_ - stats_start_ns_;
+    return span ? static_cast<double>(busy_ns_) / span : 0.0;
+  }
+
+  void reset_stats() {
+    stats_.clear();
+    busy_ns_ = 0;
+    stats_start_ns_ = now_ns_;
+  }
+
+  uint64_t now_us() const { return now_ns_ / 1000; }
+
+  // ----- bit-time 모델 -----
+  // standard(11bit): SOF..IFS = 47 + 8*dlc, stuff 대상 SOF..CRC = 34 + 8*dlc
+  // extended(29bit): 67 + 8*dlc, stuff 대상 54 + 8*dlc
+  static uint32_t frame_bits(uint32_t id, uint8_t dlc, bool worst_case_stuffing) {
+    const bool ext = id > 0x7FF;
+    const uint32_t n = std::min<uint32_t>(dlc, 8) * 8;
+    const uint32_t base = (ext ? 67u : 47u) + n;
+    const uint32_t stuffed = (ext ? 54u : 34u) + n;
+    return base + (worst_case_stuffing ? (stuffed - 1) / 4 : 0);
+  }
+
+  uint64_t frame_time_ns(const CanFrame& f) const {
+    return static_cast<uint64_t>(frame_bits(f.id, f.dlc, cfg_.worst_case_stuffing)) *
+           1000000000ull / cfg_.bitrate;
+  }
+
+private:
+  struct Request {
+    uint64_t req_ns;
+    uint64_t seq;
+    NodeId   node;
+    CanFrame frame;
+  };
+
+  struct InFlight {
+    Request  req;
+    uint64_t start_ns;
+    uint64_t end_ns;
+  };
+
+  // 요청 시간 순 (아직 arbitration 참가 전)
+  struct RequestedLater {
+    bool operator()(const Request& a, const Request& b) const {
+      if (a.req_ns != b.req_ns) return a.req_ns > b.req_ns;
+      return a.seq > b.seq;
+    }
+  };
+
+  // arbitration 우선순위: 낮은 ID, 같은 ID면 먼저 요청된 것
+  struct LosesArbitration {
+    bool operator()(const Request& a, const Request& b) const {
+      if (a.frame.id != b.frame.id) return a.frame.id > b.frame.id;
+      return a.seq > b.seq;
+    }
+  };
+
+  // t까지 요청된 프레임을 arbitration 후보로
+  void promote_(uint64_t t) {
+    while (!waiting_.empty() && waiting_.top().req_ns <= t) {
+      ready_.push(waiting_.top());
+      waiting_.pop();
+    }
+  }
+
+  void deliver_(const InFlight& x) {
+    CanFrame f = x.req.frame;
+    f.t_us = x.end_ns / 1000;   // 수신 timestamp = 전송 완료 시각
+    for (NodeId n = 0; n < rx_.size(); ++n) {
+      if (n != x.req.node) rx_[n].push_back(f);
+    }
+
+    IdStats& s = stats_[x.req.frame.id];
+    const double q_us = (x.start_ns - x.req.req_ns) / 1000.0;
+    const double l_us = (x.end_ns - x.req.req_ns) / 1000.0;
+    s.frames++;
+    s.sum_queue_us += q_us;
+    s.max_queue_us = std::max(s.max_queue_us, q_us);
+    s.sum_latency_us += l_us;
+    s.max_latency_us = std::max(s.max_latency_us, l_us);
+  }
+
+  Config cfg_;
+
+  uint64_t now_ns_ = 0;
+  uint64_t bus_free_ns_ = 0;
+  uint64_t seq_ = 0;
+
+  std::priority_queue<Request, std::vector<Request>, RequestedLater>   waiting_;
+  std::priority_queue<Request, std::vector<Request>, LosesArbitration> ready_;
+  std::optional<InFlight> in_flight_;
+
+  std::vector<std::deque<CanFrame>> rx_;
+
+  std::map<uint32_t, IdStats> stats_;
+  uint64_t busy_ns_ = 0;
+  uint64_t stats_start_ns_ = 0;
+};
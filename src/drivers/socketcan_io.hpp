@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../../include/io/input_source.hpp"
+#include "../../include/io/output_sink.hpp"
+#include "socketcan_port.hpp"
+#include "fakecan_codec.hpp"
+
+// =====================
+// SocketCAN <-> IInputSource / IOutputSink (단일 스레드에서 직접 사용할 때)
+// - SocketCanInputSource: 한 번의 read()에서 recvmmsg로 도착분 전부 decode,
+//   0x100만 반영 (port 필터가 이미 걸러줌), t_us = 마지막 0x100의 kernel RX timestamp (SteadyClock 시간축)
+//   wait(timeout_us): 0x100이 올 때까지 잠 (필터 밖 프레임으로는 안 깸)
+// - SocketCanOutputSink : 0x200 (+ fault_code 바뀌면 0x300)을 sendmmsg 한 번으로
+// - 스레드를 나누려면 SocketCanPort를 CanIoThread에 넘김
+// =====================
+class SocketCanInputSource final : public IInputSource {
+public:
+    explicit SocketCanInputSource(SocketCanPort& port) : port_(port) {}
+
+    bool read(InputFrame& frame) override {
+        bool got = false;
+        std::size_t n;
+        do {
+            n = port_.receive(buf_, SocketCanPort::BATCH, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!can_msg::Cmd::match(buf_[i])) continue;
+                decode_cmd(buf_[i], frame_.in);
+                frame_.t_us = buf_[i].t_us;
+                got = true;
+            }
+        } while (n == SocketCanPort::BATCH);   // batch가 꽉 찼으면 더 남아 있을 수 있음
+
+        if (!got) return false;
+        frame_.valid = true;
+        frame = frame_;
+        return true;
+    }
+
+    bool wait(std::uint64_t timeout_us) const { return port_.wait_readable(timeout_us); }
+
+private:
+    SocketCanPort& port_;
+    InputFrame frame_{};
+    CanFrame buf_[SocketCanPort::BATCH];
+};
+
+class SocketCanOutputSink final : public IOutputSink {
+public:
+    explicit SocketCanOutputSink(SocketCanPort& port) : port_(port) {}
+
+    void write(const OutputFrame& frame) override {
+        CanFrame tx[2];
+        std::size_t k = 0;
+        tx[k] = encode_act(frame.out);
+        tx[k++].t_us = frame.t_us;
+        if (frame.out.fault_code != last_fault_code_) {
+            tx[k] = encode_diag(frame.out);
+            tx[k++].t_us = frame.t_us;
+            last_fault_code_ = frame.out.fault_code;
+        }
+        const std::size_t sent = port_.send(tx, k, frame.t_us);
+        dropped_ += k - sent;
+    }
+
+    std::uint64_t dropped() const { return dropped_; }
+
+private:
+    SocketCanPort& port_;
+    std::uint16_t last_fault_code_ = 0;
+    std::uint64_t dropped_ = 0;
+};
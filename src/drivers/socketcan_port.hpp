@@ -0,0 +1,223 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "can_port.hpp"
+
+// =====================
+// SocketCAN raw port (Linux 전용, 로컬 시험은 vcan0)
+//   sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+// - 수신: recvmmsg 한 번에 최대 BATCH개 (MSG_DONTWAIT, 막히지 않음)
+// - 송신: sendmmsg 한 번에 최대 BATCH개
+// - CAN_RAW_FILTER: 커널에서 id 필터 -> 필터 밖 프레임은 socket을 깨우지 않음
+// - SO_TIMESTAMPING: hardware(raw) timestamp가 있으면 그것, 없으면 kernel RX software
+//   timestamp를 CanFrame::t_us에. runtime의 다른 t_us와 섞이므로 SteadyClock(CLOCK_MONOTONIC)
+//   시간축으로 바꿔서 넣음
+//   software(CLOCK_REALTIME): receive마다 잰 REALTIME-MONOTONIC offset을 뺌
+//   hardware(NIC clock): 처음 본 hw timestamp를 그 순간의 MONOTONIC에 맞춤
+// - 열기 실패는 is_open()/error()로 확인 (예외 없음)
+// =====================
+class SocketCanPort final : public ICanPort {
+public:
+    static constexpr std::size_t BATCH = 32;
+    static constexpr std::size_t MAX_FILTERS = 8;
+
+    struct Config {
+        // {id, mask} 쌍, count = 0 이면 모든 프레임
+        can_filter filters[MAX_FILTERS] = {{0x100, CAN_SFF_MASK}};
+        std::size_t filter_count = 1;
+        bool timestamping = true;
+        bool loopback = false;   // 같은 host의 다른 socket이 보낸 프레임도 받을지
+    };
+
+    explicit SocketCanPort(const std::string& ifname) : SocketCanPort(ifname, Config{}) {}
+    SocketCanPort(const std::string& ifname, const Config& cfg) { open_(ifname, cfg); }
+
+    ~SocketCanPort() override {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    SocketCanPort(const SocketCanPort&) = delete;
+    SocketCanPort& operator=(const SocketCanPort&) = delete;
+
+    bool is_open() const { return fd_ >= 0; }
+    const std::string& error() const { return error_; }
+    int fd() const { return fd_; }
+
+    // hw timestamp가 한 번이라도 들어왔는지 (없으면 kernel software timestamp)
+    bool hw_timestamps() const { return hw_ts_seen_; }
+    std::uint64_t rx_errors() const { return rx_errors_; }
+    std::uint64_t tx_errors() const { return tx_errors_; }
+
+    // 필터를 통과한 프레임이 올 때까지 최대 timeout_us 대기 (0 = 바로 확인)
+    bool wait_readable(std::uint64_t timeout_us) const {
+        if (fd_ < 0) return false;
+        pollfd p{fd_, POLLIN, 0};
+        timespec ts{static_cast<time_t>(timeout_us / 1000000),
+                    static_cast<long>((timeout_us % 1000000) * 1000)};
+        return ::ppoll(&p, 1, &ts, nullptr) > 0 && (p.revents & POLLIN);
+    }
+
+    std::size_t receive(CanFrame* out, std::size_t max, std::uint64_t) override {
+        if (fd_ < 0 || max == 0) return 0;
+        const unsigned n_req = static_cast<unsigned>(max < BATCH ? max : BATCH);
+        for (unsigned i = 0; i < n_req; ++i) {
+            iov_[i] = {&raw_[i], sizeof(can_frame)};
+            msgs_[i] = {};
+            msgs_[i].msg_hdr.msg_iov = &iov_[i];
+            msgs_[i].msg_hdr.msg_iovlen = 1;
+            msgs_[i].msg_hdr.msg_control = ctrl_[i];
+            msgs_[i].msg_hdr.msg_controllen = sizeof(ctrl_[i]);
+        }
+
+        const int n = ::recvmmsg(fd_, msgs_, n_req, MSG_DONTWAIT, nullptr);
+        if (n <= 0) {
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) ++rx_errors_;
+            return 0;
+        }
+
+        rt_to_mono_us_ = realtime_to_mono_us_();
+        std::size_t k = 0;
+        for (int i = 0; i < n; ++i) {
+            if (msgs_[i].msg_len < sizeof(can_frame)) { ++rx_errors_; continue; }
+            const can_frame& r = raw_[i];
+            if (r.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)) continue;
+
+            CanFrame& f = out[k++];
+            f.id = r.can_id & ((r.can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+            f.dlc = r.can_dlc > 8 ? 8 : r.can_dlc;
+            std::memcpy(f.data, r.data, 8);
+            f.t_us = rx_timestamp_us_(msgs_[i].msg_hdr);
+        }
+        return k;
+    }
+
+    std::size_t send(const CanFrame* frames, std::size_t n, std::uint64_t) override {
+        if (fd_ < 0) return 0;
+        std::size_t sent = 0;
+        while (sent < n) {
+            const unsigned chunk = static_cast<unsigned>((n - sent) < BATCH ? (n - sent) : BATCH);
+            for (unsigned i = 0; i < chunk; ++i) {
+                const CanFrame& f = frames[sent + i];
+                raw_[i] = {};
+                raw_[i].can_id = f.id > CAN_SFF_MASK ? (f.id | CAN_EFF_FLAG) : f.id;
+                raw_[i].can_dlc = f.dlc > 8 ? 8 : f.dlc;
+                std::memcpy(raw_[i].data, f.data, 8);
+                iov_[i] = {&raw_[i], sizeof(can_frame)};
+                msgs_[i] = {};
+                msgs_[i].msg_hdr.msg_iov = &iov_[i];
+                msgs_[i].msg_hdr.msg_iovlen = 1;
+            }
+            const int n_ok = ::sendmmsg(fd_, msgs_, chunk, MSG_DONTWAIT);
+            if (n_ok <= 0) { ++tx_errors_; break; }   // 송신 큐 가득 -> 나머지는 버림
+            sent += static_cast<std::size_t>(n_ok);
+            if (static_cast<unsigned>(n_ok) < chunk) break;
+        }
+        return sent;
+    }
+
+private:
+    bool fail_(const char* what) {
+        error_ = std::string(what) + ": " + std::strerror(errno);
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    bool open_(const std::string& ifname, const Config& cfg) {
+        fd_ = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+        if (fd_ < 0) return fail_("socket(PF_CAN)");
+
+        const std::size_t nf = cfg.filter_count < MAX_FILTERS ? cfg.filter_count : MAX_FILTERS;
+        if (::setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, nf ? cfg.filters : nullptr,
+                         static_cast<socklen_t>(nf * sizeof(can_filter))) < 0)
+            return fail_("CAN_RAW_FILTER");
+
+        const int loopback = cfg.loopback ? 1 : 0;
+        ::setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &loopback, sizeof(loopback));
+
+        if (cfg.timestamping) {
+            const int flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                              SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+            if (::setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0)
+                return fail_("SO_TIMESTAMPING");
+        }
+
+        ifreq ifr{};
+        std::strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ - 1);
+        if (::ioctl(fd_, SIOCGIFINDEX, &ifr) < 0) return fail_(ifname.c_str());
+
+        sockaddr_can addr{};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = ifr.ifr_ifindex;
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) return fail_("bind");
+        return true;
+    }
+
+    // ts[2] = raw hardware, ts[0] = software (0이면 해당 timestamp 없음), 결과는 MONOTONIC us
+    std::uint64_t rx_timestamp_us_(msghdr& h) {
+        for (cmsghdr* c = CMSG_FIRSTHDR(&h); c; c = CMSG_NXTHDR(&h, c)) {
+            if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_TIMESTAMPING) continue;
+            scm_timestamping ts;
+            std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+            if (ts.ts[2].tv_sec || ts.ts[2].tv_nsec) {
+                const std::uint64_t hw = to_us_(ts.ts[2]);
+                if (!hw_ts_seen_) {
+                    hw_ts_seen_ = true;
+                    hw_to_mono_us_ = mono_us_() - hw;
+                }
+                return hw + hw_to_mono_us_;
+            }
+            if (ts.ts[0].tv_sec || ts.ts[0].tv_nsec) return to_us_(ts.ts[0]) - rt_to_mono_us_;
+        }
+        return mono_us_();   // timestamping 꺼짐: user space에서 읽은 시각
+    }
+
+    static std::uint64_t to_us_(const timespec& t) {
+        return static_cast<std::uint64_t>(t.tv_sec) * 1000000u + static_cast<std::uint64_t>(t.tv_nsec) / 1000u;
+    }
+
+    // SteadyClock::now_us()와 같은 값 (libstdc++ steady_clock = CLOCK_MONOTONIC)
+    static std::uint64_t mono_us_() {
+        timespec t;
+        ::clock_gettime(CLOCK_MONOTONIC, &t);
+        return to_us_(t);
+    }
+
+    // REALTIME - MONOTONIC (us, unsigned wrap으로 빼기), NTP step/slew를 따라가도록 receive마다
+    static std::uint64_t realtime_to_mono_us_() {
+        timespec rt;
+        const std::uint64_t m0 = mono_us_();
+        ::clock_gettime(CLOCK_REALTIME, &rt);
+        const std::uint64_t m1 = mono_us_();
+        return to_us_(rt) - (m0 + (m1 - m0) / 2);
+    }
+
+    int fd_ = -1;
+    std::string error_;
+    bool hw_ts_seen_ = false;
+    std::uint64_t rt_to_mono_us_ = realtime_to_mono_us_();
+    std::uint64_t hw_to_mono_us_ = 0;
+    std::uint64_t rx_errors_ = 0;
+    std::uint64_t tx_errors_ = 0;
+
+    // recvmmsg/sendmmsg 작업 버퍼 (생성 시 한 번, 이후 할당 없음)
+    can_frame raw_[BATCH]{};
+    iovec iov_[BATCH]{};
+    mmsghdr msgs_[BATCH]{};
+    alignas(cmsghdr) char ctrl_[BATCH][CMSG_SPACE(sizeof(scm_timestamping))]{};
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// =====================
+// ControllerCore::step 구간별 latency 계측 (opt-in)
+// - -DCONTROLLER_PROFILE 로 빌드할 때만 켜짐 (make PROFILE=1)
+//   꺼져 있으면 CTRL_PROF_* 매크로는 빈 문장 -> 코드/멤버 모두 사라짐
+// - 값 단위: x86은 TSC cycle, 그 외는 ns
+// - 히스토그램: HDR 스타일 log-linear bucket (2배 구간마다 16칸, 상대오차 ~6%)
+//   writer(control thread) 1개 + reader 여러 개, 모두 lock-free
+// =====================
+
+inline std::uint64_t profile_now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// profile_now() 단위 / ns (대략 10ms 측정으로 보정)
+inline double profile_ticks_per_ns() {
+#if defined(__x86_64__) || defined(__i386__)
+    using namespace std::chrono;
+    const auto w0 = steady_clock::now();
+    const std::uint64_t c0 = __rdtsc();
+    while (steady_clock::now() - w0 < milliseconds(10)) {}
+    const std::uint64_t c1 = __rdtsc();
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - w0).count();
+    return ns > 0.0 ? (c1 - c0) / ns : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 4;                    // octave당 16 bucket
+    static constexpr unsigned SUB_COUNT = 1u << SUB_BITS;
+    static constexpr unsigned OCTAVES = 64 - SUB_BITS + 1;
+    static constexpr std::size_t BUCKETS = static_cast<std::size_t>(OCTAVES) * SUB_COUNT;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram& o) { copy_from_(o); }
+    LatencyHistogram& operator=(const LatencyHistogram& o) { copy_from_(o); return *this; }
+
+    // writer는 1개뿐이라 fetch_add 대신 load+store (lock prefix 없음)
+    void record(std::uint64_t v) {
+        bump_(counts_[index_(v)]);
+        bump_(total_);
+        if (v > max_.load(std::memory_order_relaxed)) max_.store(v, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // p: 0~100, bucket 상한값 반환 (동시 기록 중이면 근사)
+    std::uint64_t percentile(double p) const {
+        const std::uint64_t n = count();
+        if (n == 0) return 0;
+        std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * n + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > n) rank = n;
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const std::uint64_t hi = upper_(i);
+                return hi < max() ? hi : max();
+            }
+        }
+        return max();
+    }
+
+    void reset() {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static void bump_(std::atomic<std::uint64_t>& a) {
+        a.store(a.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // v < 16: 그대로, 그 외: (octave, 상위 4bit) -> index
+    static std::size_t index_(std::uint64_t v) {
+        if (v < SUB_COUNT) return static_cast<std::size_t>(v);
+        const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(v));
+        const unsigned shift = msb - SUB_BITS;
+        const std::size_t sub = static_cast<std::size_t>(v >> shift) & (SUB_COUNT - 1);
+        return static_cast<std::size_t>(shift + 1) * SUB_COUNT + sub;
+    }
+
+    // bucket i에 들어가는 최댓값
+    static std::uint64_t upper_(std::size_t i) {
+        if (i < SUB_COUNT) return i;
+        const unsigned shift = static_cast<unsigned>(i / SUB_COUNT) - 1;
+        const std::uint64_t sub = i % SUB_COUNT;
+        return (((SUB_COUNT | sub) + 1) << shift) - 1;
+    }
+
+    void copy_from_(const LatencyHistogram& o) {
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+            counts_[i].store(o.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        total_.store(o.count(), std::memory_order_relaxed);
+        max_.store(o.max(), std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts_{};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+enum class StepPhase : std::uint8_t {
+    CommsFilter = 0,   // inhibit 해제 + COMMS_LOST 필터
+    FaultPick,         // 우선순위 fault 선택 + latch
+    StateHandler,      // handle_* (PID 포함)
+    DebugSnapshot,     // dbg_ 갱신
+    Total,             // step 전체
+    COUNT
+};
+
+inline const char* step_phase_name(StepPhase p) {
+    switch (p) {
+        case StepPhase::CommsFilter:   return "comms_filter";
+        case StepPhase::FaultPick:     return "fault_pick";
+        case StepPhase::StateHandler:  return "state_handler";
+        case StepPhase::DebugSnapshot: return "debug_snapshot";
+        case StepPhase::Total:         return "total";
+        default:                       return "?";
+    }
+}
+
+struct StepProfiler {
+    std::array<LatencyHistogram, static_cast<std::size_t>(StepPhase::COUNT)> phase;
+
+    LatencyHistogram& operator[](StepPhase p) { return phase[static_cast<std::size_t>(p)]; }
+    const LatencyHistogram& operator[](StepPhase p) const { return phase[static_cast<std::size_t>(p)]; }
+
+    void reset() { for (auto& h : phase) h.reset(); }
+
+    // ticks_per_ns: profile_ticks_per_ns() 결과 (1.0이면 raw 단위 그대로)
+    void print(std::ostream& os, double ticks_per_ns = 1.0) const {
+        const double k = (ticks_per_ns > 0.0) ? 1.0 / ticks_per_ns : 1.0;
+        os << "[STEP PROFILE] (ns) phase: count p50 p99 p99.99 max\n";
+        for (std::size_t i = 0; i < phase.size(); ++i) {
+            const auto& h = phase[i];
+            os << "  " << step_phase_name(static_cast<StepPhase>(i)) << ": " << h.count()
+               << " " << h.percentile(50.0) * k
+               << " " << h.percentile(99.0) * k
+               << " " << h.percentile(99.99) * k
+               << " " << h.max() * k << "\n";
+        }
+    }
+};
+
+// ----- ControllerCore::step 안에서 쓰는 매크로 -----
+#if defined(CONTROLLER_PROFILE)
+#define CTRL_PROF_START(t)          std::uint64_t t = profile_now()
+#define CTRL_PROF_LAP(t, ph)        do { const std::uint64_t now_ = profile_now(); \
+                                         profiler_[ph].record(now_ - t); t = now_; } while (0)
+#define CTRL_PROF_STOP(t, ph)       profiler_[ph].record(profile_now() - t)
+#else
+#define CTRL_PROF_START(t)          ((void)0)
+#define CTRL_PROF_LAP(t, ph)        ((void)0)
+#define CTRL_PROF_STOP(t, ph)       ((void)0)
+#endif
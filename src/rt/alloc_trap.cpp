@@ -0,0 +1,47 @@
+#include "alloc_trap.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <unistd.h>
+
+// =====================
+// AllocTrapScope 안에서의 operator new -> abort
+// (ALLOC_TRAP=1 빌드에서만 링크되는 전역 operator new/delete 교체)
+// =====================
+
+#if defined(CONTROLLER_ALLOC_TRAP)
+
+static void trap_if_armed_(std::size_t n) {
+    if (!g_alloc_trap_armed) return;
+    g_alloc_trap_armed = false;   // abort 경로에서 재귀 방지
+    static const char msg[] = "[alloc_trap] heap allocation inside AllocTrapScope (control thread)\n";
+    (void)!::write(2, msg, sizeof(msg) - 1);
+    (void)n;
+    std::abort();
+}
+
+void* operator new(std::size_t n) {
+    trap_if_armed_(n);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    trap_if_armed_(n);
+    return std::malloc(n ? n : 1);
+}
+
+void* operator new(std::size_t n, std::align_val_t al) {
+    trap_if_armed_(n);
+    const std::size_t a = static_cast<std::size_t>(al);
+    if (void* p = std::aligned_alloc(a, (n + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+// =====================
+// heap 할당 trap (debug, make ALLOC_TRAP=1 -> -DCONTROLLER_ALLOC_TRAP)
+// - AllocTrapScope가 살아있는 동안 그 스레드에서 operator new가 불리면
+//   stderr에 메시지를 쓰고 abort (core dump / debugger에서 호출 위치 확인)
+// - operator new 교체는 src/rt/alloc_trap.cpp (ALLOC_TRAP=1일 때만 링크)
+// - malloc 직접 호출은 잡지 않음
+// - 매크로가 없으면 AllocTrapScope는 빈 객체
+// =====================
+
+#if defined(CONTROLLER_ALLOC_TRAP)
+
+inline thread_local bool g_alloc_trap_armed = false;
+
+class AllocTrapScope {
+public:
+    AllocTrapScope() : prev_(g_alloc_trap_armed) { g_alloc_trap_armed = true; }
+    ~AllocTrapScope() { g_alloc_trap_armed = prev_; }
+
+    AllocTrapScope(const AllocTrapScope&) = delete;
+    AllocTrapScope& operator=(const AllocTrapScope&) = delete;
+
+private:
+    bool prev_;
+};
+
+#else
+
+class AllocTrapScope {
+public:
+    AllocTrapScope() {}
+};
+
+#endif
@@ -0,0 +1,219 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include "../../include/clock.hpp"
+
+// =====================
+// 주기 task executive (단일 스레드, cyclic)
+// - task마다 절대 release 시각 -> clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+//   (sleep_for 누적 drift 없음)
+// - 같은 시각 release면 등록 순서가 우선 (10ms control을 먼저 등록)
+// - 옵션: SCHED_FIFO 우선순위, CPU pinning, mlockall
+// - 시간원: 기본 CLOCK_MONOTONIC, IClock*을 주면 그걸로 (test: VirtualClock -> 실제로 안 잠, us 단위)
+// - task별 통계: 실행 횟수, budget 초과(overrun), deadline miss, skip된 주기,
+//   최대 실행시간, release jitter 히스토그램
+// =====================
+
+struct PeriodicTaskStats {
+    // jitter(실제 시작 - release) 히스토그램 경계 (ns), 마지막 bucket은 1ms 이상
+    static constexpr std::array<std::uint64_t, 10> JITTER_EDGES_NS = {
+        1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000
+    };
+
+    std::uint64_t runs = 0;
+    std::uint64_t overruns = 0;          // 실행시간 > budget
+    std::uint64_t deadline_misses = 0;   // 종료 시각 > release + period
+    std::uint64_t skipped_periods = 0;   // 늦어서 건너뛴 release 수
+
+    std::uint64_t max_exec_ns = 0;
+    std::uint64_t sum_exec_ns = 0;
+    std::uint64_t max_jitter_ns = 0;
+
+    std::array<std::uint64_t, JITTER_EDGES_NS.size() + 1> jitter_hist{};
+
+    void add_jitter(std::uint64_t ns) {
+        max_jitter_ns = std::max(max_jitter_ns, ns);
+        std::size_t b = 0;
+        while (b < JITTER_EDGES_NS.size() && ns >= JITTER_EDGES_NS[b]) ++b;
+        jitter_hist[b]++;
+    }
+};
+
+class PeriodicExecutive {
+public:
+    struct Config {
+        int  fifo_priority = 0;   // 0 = SCHED_OTHER 유지, 1~99 = SCHED_FIFO
+        int  cpu = -1;            // -1 = pinning 안 함
+        bool lock_memory = false; // mlockall(MCL_CURRENT | MCL_FUTURE)
+    };
+
+    struct Task {
+        std::string name;
+        std::uint64_t period_ns = 0;
+        std::uint64_t budget_ns = 0;
+        std::function<void()> fn;
+
+        std::uint64_t next_release_ns = 0;
+        PeriodicTaskStats stats;
+    };
+
+    PeriodicExecutive() : PeriodicExecutive(Config{}) {}
+    explicit PeriodicExecutive(Config cfg, IClock* clock = nullptr) : cfg_(cfg), clock_(clock) {}
+
+    // budget_us = 0 이면 period를 budget으로
+    void add_task(const std::string& name, std::uint64_t period_us, std::uint64_t budget_us,
+                  std::function<void()> fn, std::uint64_t offset_us = 0) {
+        Task t;
+        t.name = name;
+        t.period_ns = period_us * 1000;
+        t.budget_ns = (budget_us ? budget_us : period_us) * 1000;
+        t.fn = std::move(fn);
+        t.next_release_ns = offset_us * 1000;   // run() 시작 시 절대 시각으로 변환
+        tasks_.push_back(std::move(t));
+    }
+
+    // RT 설정 적용, 실패 항목은 warn에 기록 (권한 없으면 일반 스케줄링으로 계속)
+    bool apply_rt_settings(std::ostream& warn) {
+        bool ok = true;
+        if (cfg_.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            warn << "[exec] mlockall failed: " << std::strerror(errno) << "\n";
+            ok = false;
+        }
+        if (cfg_.cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cfg_.cpu, &set);
+            const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (rc != 0) {
+                warn << "[exec] CPU pinning to " << cfg_.cpu << " failed: " << std::strerror(rc) << "\n";
+                ok = false;
+            }
+        }
+        if (cfg_.fifo_priority > 0) {
+            sched_param sp{};
+            sp.sched_priority = cfg_.fifo_priority;
+            const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+            if (rc != 0) {
+                warn << "[exec] SCHED_FIFO(" << cfg_.fifo_priority << ") failed: " << std::strerror(rc) << "\n";
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    // duration_us 동안 실행 (0이면 stop()까지)
+    void run(std::uint64_t duration_us = 0) {
+        stop_ = false;
+        const std::uint64_t t0 = now_ns_();
+        const std::uint64_t t_end = duration_us ? t0 + duration_us * 1000 : UINT64_MAX;
+        for (auto& t : tasks_) t.next_release_ns += t0;
+
+        while (!stop_ && !tasks_.empty()) {
+            // 가장 이른 release (동시면 등록 순서)
+            Task* next = &tasks_[0];
+            for (auto& t : tasks_)
+                if (t.next_release_ns < next->next_release_ns) next = &t;
+
+            if (next->next_release_ns >= t_end) break;
+            sleep_until_ns_(next->next_release_ns);
+
+            const std::uint64_t release = next->next_release_ns;
+            const std::uint64_t start = now_ns_();
+            next->fn();
+            const std::uint64_t end = now_ns_();
+
+            PeriodicTaskStats& s = next->stats;
+            const std::uint64_t exec = end - start;
+            s.runs++;
+            s.sum_exec_ns += exec;
+            s.max_exec_ns = std::max(s.max_exec_ns, exec);
+            s.add_jitter(start > release ? start - release : 0);
+            if (exec > next->budget_ns) s.overruns++;
+            if (end > release + next->period_ns) s.deadline_misses++;
+
+            // 다음 release: 주기 유지, 이미 지난 release는 건너뜀 (burst 실행 방지)
+            next->next_release_ns += next->period_ns;
+            while (next->next_release_ns <= end) {
+                next->next_release_ns += next->period_ns;
+                s.skipped_periods++;
+            }
+        }
+    }
+
+    void stop() { stop_ = true; }
+
+    const std::vector<Task>& tasks() const { return tasks_; }
+
+    const PeriodicTaskStats* stats(const std::string& name) const {
+        for (const auto& t : tasks_)
+            if (t.name == name) return &t.stats;
+        return nullptr;
+    }
+
+    void print_report(std::ostream& os) const {
+        os << "\n==============================\n";
+        os << "[EXECUTIVE TIMING]\n";
+        os << "------------------------------\n";
+        for (const auto& t : tasks_) {
+            const auto& s = t.stats;
+            os << t.name << " (" << t.period_ns / 1000000.0 << " ms)"
+               << " runs=" << s.runs
+               << " overruns=" << s.overruns
+               << " deadline_miss=" << s.deadline_misses
+               << " skipped=" << s.skipped_periods
+               << " exec avg/max=" << (s.runs ? s.sum_exec_ns / s.runs : 0) / 1000.0
+               << "/" << s.max_exec_ns / 1000.0 << " us"
+               << " jitter max=" << s.max_jitter_ns / 1000.0 << " us\n";
+
+            os << "  jitter hist:";
+            for (std::size_t b = 0; b < s.jitter_hist.size(); ++b) {
+                if (b < PeriodicTaskStats::JITTER_EDGES_NS.size())
+                    os << " <" << PeriodicTaskStats::JITTER_EDGES_NS[b] / 1000 << "us:";
+                else
+                    os << " >=1ms:";
+                os << s.jitter_hist[b];
+            }
+            os << "\n";
+        }
+        os << "==============================\n";
+    }
+
+private:
+    std::uint64_t now_ns_() const {
+        if (clock_) return clock_->now_us() * 1000;
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+    }
+
+    void sleep_until_ns_(std::uint64_t t_ns) {
+        if (clock_) {
+            clock_->sleep_until_us(t_ns / 1000);
+            return;
+        }
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(t_ns / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(t_ns % 1000000000ull);
+        // EINTR이면 같은 절대 시각으로 다시
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+    }
+
+    Config cfg_;
+    IClock* clock_ = nullptr;   // nullptr = CLOCK_MONOTONIC
+    std::vector<Task> tasks_;
+    bool stop_ = false;
+};
@@ -0,0 +1,250 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "controller_core.hpp"
+#include "../include/util/spsc_ring.hpp"
+
+// =====================
+// Binary telemetry logger (CSVLogger 대체)
+// - control thread: 고정 크기 POD 레코드를 SPSC ring에 복사만 함 (할당/IO/포맷 없음)
+// - writer thread: ring -> batch 버퍼 -> fwrite (디스크 stall은 writer만 막힘)
+// - ring이 가득 차면 레코드 drop + dropped() 카운트 (control loop는 절대 대기 안 함)
+// - CSV가 필요하면 tools/telemetry_to_csv 로 변환 (CSVLogger와 같은 컬럼)
+// - 읽기는 TelemetryReader (telemetry_to_csv / test 공용)
+// =====================
+
+// 파일 헤더 (파일 맨 앞 1회)
+struct TelemetryFileHeader {
+    char magic[8] = {'C', 'T', 'L', 'T', 'L', 'M', '1', '\0'};
+    std::uint32_t version = 1;
+    std::uint32_t record_size = 0;
+    double dt_s = 0.01;
+};
+
+// bool 컬럼들은 비트로
+enum TelemetryFlag : std::uint16_t {
+    TLM_DRIVE_EN     = 1u << 0,
+    TLM_LIFT_BTN     = 1u << 1,
+    TLM_DUMP_BTN     = 1u << 2,
+    TLM_ESTOP        = 1u << 3,
+    TLM_COMMS_RAW    = 1u << 4,
+    TLM_COMMS_FILT   = 1u << 5,
+    TLM_FAULT_LATCH  = 1u << 6,
+    TLM_DRIVE_CMD    = 1u << 7,
+    TLM_LIFT_CMD     = 1u << 8,
+    TLM_DUMP_CMD     = 1u << 9,
+    TLM_WINDUP_BLOCK = 1u << 10,
+};
+
+// tick당 1개 (80 bytes)
+struct TelemetryRecord {
+    std::int32_t  tick = 0;
+    std::uint16_t flags = 0;
+    std::uint8_t  state = 0;
+    std::uint8_t  reserved0 = 0;
+    std::uint16_t fault_reason = 0;   // latch 중일 때 원인 코드, 아니면 0
+    std::uint16_t fault_code = 0;
+    std::uint32_t reserved1 = 0;
+
+    double target_vel = 0.0;
+    double vel = 0.0;
+    double motor_cmd = 0.0;
+    double integ = 0.0;
+    double u_unsat = 0.0;
+    double u_sat = 0.0;
+    double lift_p = 0.0;
+    double dump_p = 0.0;
+
+    bool has(TelemetryFlag f) const { return (flags & f) != 0; }
+};
+static_assert(std::is_trivially_copyable<TelemetryRecord>::value, "TelemetryRecord must be POD");
+static_assert(sizeof(TelemetryRecord) == 80, "TelemetryRecord layout changed");
+
+inline TelemetryRecord make_telemetry_record(int tick,
+                                             const Inputs& in,
+                                             const Outputs& out,
+                                             const ControllerDebug& dbg,
+                                             double lift_p, double dump_p) {
+    TelemetryRecord r;
+    r.tick = tick;
+    r.state = static_cast<std::uint8_t>(dbg.state);
+    r.fault_reason = dbg.fault_latched ? dbg.fault_code : 0;
+    r.fault_code = dbg.fault_code;
+
+    std::uint16_t f = 0;
+    if (in.drive_enable)            f |= TLM_DRIVE_EN;
+    if (in.lift_request)            f |= TLM_LIFT_BTN;
+    if (in.dump_request)            f |= TLM_DUMP_BTN;
+    if (in.estop_button)            f |= TLM_ESTOP;
+    if (in.comms_ok)                f |= TLM_COMMS_RAW;
+    if (dbg.comms_ok_filtered)      f |= TLM_COMMS_FILT;
+    if (dbg.fault_latched)          f |= TLM_FAULT_LATCH;
+    if (out.drive_cmd)              f |= TLM_DRIVE_CMD;
+    if (out.lift_cmd)               f |= TLM_LIFT_CMD;
+    if (out.dump_cmd)               f |= TLM_DUMP_CMD;
+    if (dbg.pid_dbg.would_worsen)   f |= TLM_WINDUP_BLOCK;
+    r.flags = f;
+
+    r.target_vel = in.target_velocity;
+    r.vel = in.velocity;
+    r.motor_cmd = out.motor_cmd;
+    r.integ = dbg.pid_dbg.integ;
+    r.u_unsat = dbg.pid_dbg.u_unsat;
+    r.u_sat = dbg.pid_dbg.u_sat;
+    r.lift_p = lift_p;
+    r.dump_p = dump_p;
+    return r;
+}
+
+class TelemetryLogger {
+public:
+    static constexpr std::size_t RING_SIZE  = 4096;  // 10ms tick 기준 ~40s 여유
+    static constexpr std::size_t BATCH_SIZE = 256;   // writer 1회 fwrite 단위
+
+    TelemetryLogger(const std::string& path, double dt_s, bool enable = true)
+        : enabled_(enable) {
+        if (!enabled_) return;
+
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) { enabled_ = false; return; }
+
+        TelemetryFileHeader h;
+        h.record_size = sizeof(TelemetryRecord);
+        h.dt_s = dt_s;
+        std::fwrite(&h, sizeof(h), 1, file_);
+
+        // 할당은 여기서 끝 (control loop 중 할당 없음)
+        ring_ = std::make_unique<SpscRing<TelemetryRecord, RING_SIZE>>();
+        batch_ = std::make_unique<TelemetryRecord[]>(BATCH_SIZE);
+        writer_ = std::thread([this] { writer_loop_(); });
+    }
+
+    ~TelemetryLogger() {
+        if (writer_.joinable()) {
+            stop_.store(true, std::memory_order_release);
+            writer_.join();
+        }
+        if (file_) std::fclose(file_);
+    }
+
+    TelemetryLogger(const TelemetryLogger&) = delete;
+    TelemetryLogger& operator=(const TelemetryLogger&) = delete;
+
+    // control thread에서 호출: 복사 1회 + atomic store
+    bool log(const TelemetryRecord& r) {
+        if (!enabled_) return false;
+        if (ring_->try_push(r)) return true;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool enabled() const { return enabled_; }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    // ring에서 batch만큼 꺼내 한 번에 씀 (ring / batch 이중 버퍼)
+    std::size_t drain_once_() {
+        std::size_t n = 0;
+        while (n < BATCH_SIZE && ring_->try_pop(batch_[n])) ++n;
+        if (n > 0) {
+            std::fwrite(batch_.get(), sizeof(TelemetryRecord), n, file_);
+            written_.fetch_add(n, std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    void writer_loop_() {
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (drain_once_() == 0) {
+                std::fflush(file_);
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        // 종료 시 남은 레코드 모두 기록
+        while (drain_once_() > 0) {}
+        std::fflush(file_);
+    }
+
+    bool enabled_ = true;
+    std::FILE* file_ = nullptr;
+
+    std::unique_ptr<SpscRing<TelemetryRecord, RING_SIZE>> ring_;
+    std::unique_ptr<TelemetryRecord[]> batch_;
+
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> written_{0};
+
+    std::thread writer_;
+};
+
+// 파일을 batch 단위로 읽기 (전체를 메모리에 올리지 않음, 끝에 잘린 레코드는 버림)
+class TelemetryReader {
+public:
+    static constexpr std::size_t BATCH_SIZE = 256;   // fread 1회 단위
+
+    explicit TelemetryReader(const std::string& path) {
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_) {
+            error_ = "cannot open " + path;
+            return;
+        }
+        const TelemetryFileHeader expect;
+        if (std::fread(&header_, sizeof(header_), 1, file_) != 1 ||
+            std::memcmp(header_.magic, expect.magic, sizeof(expect.magic)) != 0 ||
+            header_.version != expect.version || header_.record_size != sizeof(TelemetryRecord)) {
+            error_ = "not a telemetry file (or version mismatch): " + path;
+            std::fclose(file_);
+            file_ = nullptr;
+            return;
+        }
+        // 레코드 수 = (파일 크기 - 헤더) / record_size
+        std::fseek(file_, 0, SEEK_END);
+        const long bytes = std::ftell(file_) - static_cast<long>(sizeof(header_));
+        count_ = bytes > 0 ? static_cast<std::uint64_t>(bytes) / sizeof(TelemetryRecord) : 0;
+        batch_ = std::make_unique<TelemetryRecord[]>(BATCH_SIZE);
+    }
+
+    ~TelemetryReader() {
+        if (file_) std::fclose(file_);
+    }
+
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    double dt_s() const { return header_.dt_s; }
+    std::uint64_t record_count() const { return count_; }
+
+    // 파일 순서대로 fn(const TelemetryRecord&), 부를 때마다 처음부터 / 넘긴 레코드 수 반환
+    template <typename Fn>
+    std::uint64_t for_each(Fn&& fn) {
+        if (!file_) return 0;
+        std::fseek(file_, static_cast<long>(sizeof(header_)), SEEK_SET);
+        std::uint64_t n = 0;
+        std::size_t got;
+        while ((got = std::fread(batch_.get(), sizeof(TelemetryRecord), BATCH_SIZE, file_)) > 0) {
+            for (std::size_t i = 0; i < got; ++i) fn(static_cast<const TelemetryRecord&>(batch_[i]));
+            n += got;
+        }
+        return n;
+    }
+
+private:
+    std::FILE* file_ = nullptr;
+    std::string error_;
+    TelemetryFileHeader header_{};
+    std::uint64_t count_ = 0;
+    std::unique_ptr<TelemetryRecord[]> batch_;
+};
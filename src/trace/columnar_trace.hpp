@@ -0,0 +1,305 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../telemetry_logger.hpp"
+
+// =====================
+// Columnar trace (.ctr): signal마다 연속 배열 하나, mmap으로 쓰고 읽음
+//   [TraceFileHeader][TraceColumnDesc x column_count] ... [column 0][column 1] ...
+//   - column은 capacity개 원소 크기로 미리 잡고 page(4096) 정렬
+//   - header.rows = 채워진 행 수 (append마다 갱신 -> 중간에 죽어도 읽을 수 있음)
+// - writer: 생성 시 ftruncate로 파일 크기 확정 (sparse) + MAP_SHARED,
+//   append는 메모리 store만 (syscall 없음), 가득 차면 false + dropped()
+// - reader: 파일 전체 PROT_READ mmap, column<T>(name)이 배열 포인터를 그대로 줌 (parse 없음)
+// - 컬럼은 CSVLogger 헤더와 같은 이름/순서 (fault_reason은 코드값)
+// - 실패는 is_open()/error() (예외 없음), 같은 머신(엔디안)에서 읽는다고 가정
+// =====================
+
+enum class TraceType : std::uint8_t { I32 = 1, U8 = 2, U16 = 3, F64 = 4 };
+
+struct TraceFileHeader {
+    char magic[8] = {'C', 'T', 'L', 'C', 'O', 'L', '1', '\0'};
+    std::uint32_t version = 1;
+    std::uint32_t column_count = 0;
+    std::uint64_t capacity = 0;   // column당 원소 수
+    std::uint64_t rows = 0;       // 채워진 행 수
+    double dt_s = 0.01;
+    std::uint64_t reserved = 0;
+};
+static_assert(sizeof(TraceFileHeader) == 48, "TraceFileHeader layout changed");
+
+struct TraceColumnDesc {
+    char name[24] = {};
+    std::uint8_t type = 0;        // TraceType
+    std::uint8_t elem_size = 0;
+    std::uint16_t reserved0 = 0;
+    std::uint32_t reserved1 = 0;
+    std::uint64_t offset = 0;     // 파일 시작부터 byte
+};
+static_assert(sizeof(TraceColumnDesc) == 40, "TraceColumnDesc layout changed");
+
+template <class T> struct TraceTypeOf;
+template <> struct TraceTypeOf<std::int32_t>  { static constexpr TraceType value = TraceType::I32; };
+template <> struct TraceTypeOf<std::uint8_t>  { static constexpr TraceType value = TraceType::U8; };
+template <> struct TraceTypeOf<std::uint16_t> { static constexpr TraceType value = TraceType::U16; };
+template <> struct TraceTypeOf<double>        { static constexpr TraceType value = TraceType::F64; };
+
+// ---------- 컬럼 정의 (CSVLogger 순서) ----------
+enum TraceCol : std::uint32_t {
+    TC_TICK, TC_TIME_S, TC_STATE,
+    TC_DRIVE_EN, TC_LIFT_BTN, TC_DUMP_BTN, TC_ESTOP,
+    TC_COMMS_RAW, TC_COMMS_FILT,
+    TC_FAULT_LATCH, TC_FAULT_REASON, TC_FAULT_CODE,
+    TC_DRIVE_CMD, TC_LIFT_CMD, TC_DUMP_CMD,
+    TC_TARGET_VEL, TC_VEL, TC_MOTOR_CMD,
+    TC_INTEG, TC_U_UNSAT, TC_U_SAT, TC_WINDUP_BLOCK,
+    TC_LIFT_P, TC_DUMP_P,
+    TC_COUNT
+};
+
+struct TraceColumnSpec {
+    const char* name;
+    TraceType type;
+};
+
+inline constexpr TraceColumnSpec TRACE_COLUMNS[TC_COUNT] = {
+    {"tick", TraceType::I32}, {"time_s", TraceType::F64}, {"state", TraceType::U8},
+    {"drive_en", TraceType::U8}, {"lift_btn", TraceType::U8}, {"dump_btn", TraceType::U8}, {"estop", TraceType::U8},
+    {"comms_raw", TraceType::U8}, {"comms_filt", TraceType::U8},
+    {"fault_latch", TraceType::U8}, {"fault_reason", TraceType::U16}, {"fault_code", TraceType::U16},
+    {"drive_cmd", TraceType::U8}, {"lift_cmd", TraceType::U8}, {"dump_cmd", TraceType::U8},
+    {"target_vel", TraceType::F64}, {"vel", TraceType::F64}, {"motor_cmd", TraceType::F64},
+    {"integ", TraceType::F64}, {"u_unsat", TraceType::F64}, {"u_sat", TraceType::F64}, {"windup_block", TraceType::U8},
+    {"lift_p", TraceType::F64}, {"dump_p", TraceType::F64},
+};
+
+inline constexpr std::size_t trace_elem_size(TraceType t) {
+    return t == TraceType::F64 ? 8 : t == TraceType::I32 ? 4 : t == TraceType::U16 ? 2 : 1;
+}
+
+// 파일에서 읽은 type byte가 TraceType 중 하나인지
+inline constexpr bool trace_type_known(std::uint8_t t) {
+    return t >= static_cast<std::uint8_t>(TraceType::I32) && t <= static_cast<std::uint8_t>(TraceType::F64);
+}
+
+// ---------- writer ----------
+class ColumnarTraceWriter {
+public:
+    static constexpr std::size_t PAGE = 4096;
+
+    ColumnarTraceWriter(const std::string& path, std::uint64_t capacity_rows, double dt_s) {
+        open_(path, capacity_rows, dt_s);
+    }
+
+    ~ColumnarTraceWriter() { close(); }
+
+    ColumnarTraceWriter(const ColumnarTraceWriter&) = delete;
+    ColumnarTraceWriter& operator=(const ColumnarTraceWriter&) = delete;
+
+    bool is_open() const { return base_ != nullptr; }
+    const std::string& error() const { return error_; }
+    std::uint64_t rows() const { return hdr_ ? hdr_->rows : 0; }
+    std::uint64_t capacity() const { return hdr_ ? hdr_->capacity : 0; }
+    std::uint64_t dropped() const { return dropped_; }
+
+    // TelemetryRecord 1개 -> 각 column의 row 번째 원소
+    bool append(const TelemetryRecord& r) {
+        if (!hdr_ || hdr_->rows == hdr_->capacity) { ++dropped_; return false; }
+        const std::uint64_t i = hdr_->rows;
+        const auto b = [&](TelemetryFlag fl) { return static_cast<std::uint8_t>(r.has(fl) ? 1 : 0); };
+
+        col_<std::int32_t>(TC_TICK)[i] = r.tick;
+        col_<double>(TC_TIME_S)[i] = r.tick * hdr_->dt_s;
+        col_<std::uint8_t>(TC_STATE)[i] = r.state;
+        col_<std::uint8_t>(TC_DRIVE_EN)[i] = b(TLM_DRIVE_EN);
+        col_<std::uint8_t>(TC_LIFT_BTN)[i] = b(TLM_LIFT_BTN);
+        col_<std::uint8_t>(TC_DUMP_BTN)[i] = b(TLM_DUMP_BTN);
+        col_<std::uint8_t>(TC_ESTOP)[i] = b(TLM_ESTOP);
+        col_<std::uint8_t>(TC_COMMS_RAW)[i] = b(TLM_COMMS_RAW);
+        col_<std::uint8_t>(TC_COMMS_FILT)[i] = b(TLM_COMMS_FILT);
+        col_<std::uint8_t>(TC_FAULT_LATCH)[i] = b(TLM_FAULT_LATCH);
+        col_<std::uint16_t>(TC_FAULT_REASON)[i] = r.fault_reason;
+        col_<std::uint16_t>(TC_FAULT_CODE)[i] = r.fault_code;
+        col_<std::uint8_t>(TC_DRIVE_CMD)[i] = b(TLM_DRIVE_CMD);
+        col_<std::uint8_t>(TC_LIFT_CMD)[i] = b(TLM_LIFT_CMD);
+        col_<std::uint8_t>(TC_DUMP_CMD)[i] = b(TLM_DUMP_CMD);
+        col_<double>(TC_TARGET_VEL)[i] = r.target_vel;
+        col_<double>(TC_VEL)[i] = r.vel;
+        col_<double>(TC_MOTOR_CMD)[i] = r.motor_cmd;
+        col_<double>(TC_INTEG)[i] = r.integ;
+        col_<double>(TC_U_UNSAT)[i] = r.u_unsat;
+        col_<double>(TC_U_SAT)[i] = r.u_sat;
+        col_<std::uint8_t>(TC_WINDUP_BLOCK)[i] = b(TLM_WINDUP_BLOCK);
+        col_<double>(TC_LIFT_P)[i] = r.lift_p;
+        col_<double>(TC_DUMP_P)[i] = r.dump_p;
+
+        hdr_->rows = i + 1;
+        return true;
+    }
+
+    // 커널에 flush 요청 (비동기), 끝까지 기다리려면 close()
+    void sync_async() {
+        if (base_) ::msync(base_, size_, MS_ASYNC);
+    }
+
+    void close() {
+        if (base_) {
+            ::msync(base_, size_, MS_SYNC);
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            hdr_ = nullptr;
+        }
+        if (fd_ >= 0) { ::close(fd_); fd_ = -1; }
+    }
+
+private:
+    template <class T>
+    T* col_(TraceCol c) { return reinterpret_cast<T*>(base_ + desc_[c].offset); }
+
+    static std::uint64_t page_up_(std::uint64_t n) { return (n + PAGE - 1) / PAGE * PAGE; }
+
+    bool fail_(const std::string& what) {
+        error_ = what + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    bool open_(const std::string& path, std::uint64_t capacity, double dt_s) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) return fail_(path);
+
+        TraceFileHeader h;
+        h.column_count = TC_COUNT;
+        h.capacity = capacity;
+        h.dt_s = dt_s;
+
+        TraceColumnDesc desc[TC_COUNT];
+        std::uint64_t off = page_up_(sizeof(h) + sizeof(desc));
+        for (std::uint32_t c = 0; c < TC_COUNT; ++c) {
+            std::strncpy(desc[c].name, TRACE_COLUMNS[c].name, sizeof(desc[c].name) - 1);
+            desc[c].type = static_cast<std::uint8_t>(TRACE_COLUMNS[c].type);
+            desc[c].elem_size = static_cast<std::uint8_t>(trace_elem_size(TRACE_COLUMNS[c].type));
+            desc[c].offset = off;
+            off += page_up_(capacity * desc[c].elem_size);
+        }
+        size_ = off;
+
+        // 크기 확정 (sparse, 디스크는 쓴 page만)
+        if (::ftruncate(fd_, static_cast<off_t>(size_)) < 0) return fail_("ftruncate");
+        void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) return fail_("mmap");
+        base_ = static_cast<std::uint8_t*>(p);
+        ::madvise(base_, size_, MADV_SEQUENTIAL);
+
+        std::memcpy(base_, &h, sizeof(h));
+        std::memcpy(base_ + sizeof(h), desc, sizeof(desc));
+        hdr_ = reinterpret_cast<TraceFileHeader*>(base_);
+        std::memcpy(desc_, desc, sizeof(desc));
+        return true;
+    }
+
+    int fd_ = -1;
+    std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    TraceFileHeader* hdr_ = nullptr;
+    TraceColumnDesc desc_[TC_COUNT];
+    std::uint64_t dropped_ = 0;
+    std::string error_;
+};
+
+// ---------- reader ----------
+class ColumnarTraceReader {
+public:
+    explicit ColumnarTraceReader(const std::string& path) { open_(path); }
+
+    ~ColumnarTraceReader() {
+        if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+    }
+
+    ColumnarTraceReader(const ColumnarTraceReader&) = delete;
+    ColumnarTraceReader& operator=(const ColumnarTraceReader&) = delete;
+
+    bool is_open() const { return base_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    std::uint64_t rows() const { return hdr_.rows; }
+    double dt_s() const { return hdr_.dt_s; }
+    std::uint32_t column_count() const { return hdr_.column_count; }
+    const TraceColumnDesc& desc(std::uint32_t i) const { return descs_()[i]; }
+
+    // 이름/타입이 맞으면 rows()개 배열, 아니면 nullptr
+    template <class T>
+    const T* column(const char* name) const {
+        if (!base_) return nullptr;
+        for (std::uint32_t c = 0; c < hdr_.column_count; ++c) {
+            const TraceColumnDesc& d = descs_()[c];
+            if (std::strncmp(d.name, name, sizeof(d.name)) != 0) continue;
+            if (d.type != static_cast<std::uint8_t>(TraceTypeOf<T>::value)) return nullptr;
+            return reinterpret_cast<const T*>(base_ + d.offset);
+        }
+        return nullptr;
+    }
+
+    template <class T>
+    const T* column(TraceCol c) const { return column<T>(TRACE_COLUMNS[c].name); }
+
+private:
+    const TraceColumnDesc* descs_() const {
+        return reinterpret_cast<const TraceColumnDesc*>(base_ + sizeof(TraceFileHeader));
+    }
+
+    bool fail_(const std::string& what) {
+        error_ = what;
+        if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+        base_ = nullptr;
+        return false;
+    }
+
+    bool open_(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return fail_(path + ": " + std::strerror(errno));
+        struct stat st{};
+        if (::fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(TraceFileHeader))) {
+            ::close(fd);
+            return fail_(path + ": too small");
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);   // mapping은 fd 없이 유지됨
+        if (p == MAP_FAILED) return fail_(path + ": mmap: " + std::strerror(errno));
+        base_ = static_cast<const std::uint8_t*>(p);
+        ::madvise(const_cast<std::uint8_t*>(base_), size_, MADV_SEQUENTIAL);
+
+        std::memcpy(&hdr_, base_, sizeof(hdr_));
+        const TraceFileHeader expect;
+        if (std::memcmp(hdr_.magic, expect.magic, sizeof(hdr_.magic)) != 0 || hdr_.version != expect.version)
+            return fail_(path + ": not a columnar trace (or version mismatch)");
+        if (hdr_.rows > hdr_.capacity ||
+            hdr_.column_count > (size_ - sizeof(TraceFileHeader)) / sizeof(TraceColumnDesc))
+            return fail_(path + ": corrupt header");
+        // column<T>()는 type만 보고 sizeof(T) x rows 를 읽으므로 elem_size/정렬/범위를 여기서 다 확인
+        for (std::uint32_t c = 0; c < hdr_.column_count; ++c) {
+            const TraceColumnDesc& d = descs_()[c];
+            if (!trace_type_known(d.type) || d.elem_size != trace_elem_size(static_cast<TraceType>(d.type)))
+                return fail_(path + ": bad column type");
+            if (d.offset % d.elem_size != 0) return fail_(path + ": misaligned column");
+            if (d.offset > size_ || hdr_.capacity > (size_ - d.offset) / d.elem_size)
+                return fail_(path + ": column out of range");
+        }
+        return true;
+    }
+
+    const std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    TraceFileHeader hdr_{};
+    std::string error_;
+};
@@ -1,4 +1,6 @@
+#pragma once
 #include <vector>
+#include <cstddef>
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -43,104 +45,119 @@ struct StepResult {
   PassFail pf;
 };
 
-inline Metrics compute_metrics_step(const std::vector<Sample>& log,
-                                    double step_time,
-                                    double t_end,
-                                    double v0,
-                                    double v1) {
-  Metrics m{};
-  const double delta = v1 - v0;
+// =====================
+// Single-pass streaming 버전: 샘플을 하나씩 받아 O(1) 메모리로 Metrics 계산
+// - 샘플 t는 단조 증가한다고 가정 (runner 로그와 동일)
+// - 결과는 기존 5-pass 구현과 동일 (settling: 마지막 band 이탈 이후 첫 샘플)
+// =====================
+class StepMetricsAccumulator {
+public:
+  StepMetricsAccumulator(double step_time, double t_end, double v0, double v1)
+      : step_time_(step_time), t_end_(t_end), v1_(v1), delta_(v1 - v0),
+        thr_(v0 + 0.9 * (v1 - v0)),
+        peak_((v1 - v0 >= 0.0) ? -1e9 : 1e9),
+        lo_(v1 - 0.05 * std::max(1e-9, std::abs(v1))),
+        hi_(v1 + 0.05 * std::max(1e-9, std::abs(v1))),
+        ss_t0_(std::max(step_time, t_end - 0.5)) {}
+
+  void add(const Sample& s) {
+    if (s.t < step_time_ || s.t >= t_end_) return;
+
+    // 1) 90% transition time (첫 도달)
+    if (std::isnan(m_.rise_time)) {
+      if (delta_ >= 0.0 ? (s.vel >= thr_) : (s.vel <= thr_)) m_.rise_time = s.t - step_time_;
+    }
+
+    // 2) peak
+    if (delta_ >= 0.0) peak_ = std::max(peak_, s.vel);
+    else               peak_ = std::min(peak_, s.vel);
 
-  // 1) 90% transition time
-  const double thr = v0 + 0.9 * delta;
-  for (size_t i = 0; i < log.size(); ++i) {
-    const auto& s = log[i];
-    if (s.t < step_time || s.t >= t_end) continue;
+    // 3) settling: band 이탈하면 후보 취소, band 안 첫 샘플이 새 후보
+    if (s.vel < lo_ || s.vel > hi_) settle_t_ = std::numeric_limits<double>::quiet_NaN();
+    else if (std::isnan(settle_t_)) settle_t_ = s.t;
 
-    if (delta >= 0.0) {
-      if (s.vel >= thr) { m.rise_time = s.t - step_time; break; }
+    // 4) steady-state: 마지막 0.5s 평균
+    if (s.t >= ss_t0_) { ss_sum_ += s.vel; ss_cnt_++; }
+
+    // 5) 연속 saturation 최대 길이
+    const bool sat = (std::abs(s.u) >= 0.999);
+    if (sat) {
+      if (std::isfinite(last_t_)) sat_cur_ += (s.t - last_t_);
     } else {
-      if (s.vel <= thr) { m.rise_time = s.t - step_time; break; }
+      sat_best_ = std::max(sat_best_, sat_cur_);
+      sat_cur_ = 0.0;
     }
+    last_t_ = s.t;
   }
 
-  // 2) Overshoot/undershoot (% of |delta|)
-  double peak = (delta >= 0.0) ? -1e9 : 1e9;
-  for (const auto& s : log) {
-    if (s.t < step_time || s.t >= t_end) continue;
-    if (delta >= 0.0) peak = std::max(peak, s.vel);
-    else              peak = std::min(peak, s.vel);
-  }
-  const double mag = (delta >= 0.0) ? (peak - v1) : (v1 - peak);
-  if (std::abs(delta) > 1e-9) m.overshoot_pct = std::max(0.0, mag / std::abs(delta) * 100.0);
-  else m.overshoot_pct = 0.0;
-
-  // 3) Settling time: must stay within band until t_end
-  const double band = 0.05 * std::max(1e-9, std::abs(v1));
-  const double lo = v1 - band;
-  const double hi = v1 + band;
-
-  for (size_t i = 0; i < log.size(); ++i) {
-    const auto& si = log[i];
-    if (si.t < step_time || si.t >= t_end) continue;
-
-    bool stays = true;
-    for (size_t j = i; j < log.size(); ++j) {
-      const auto& sj = log[j];
-      if (sj.t < step_time) continue;
-      if (sj.t >= t_end) break;
-      if (sj.vel < lo || sj.vel > hi) { stays = false; break; }
-    }
-    if (stays) { m.settling_time = si.t - step_time; break; }
+  // columnar trace (mmap 배열)를 그대로: 행 i = Sample{t[i], target[i], vel[i], u[i]}
+  void add_columns(const double* t, const double* target, const double* vel, const double* u, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) add(Sample{t[i], target[i], vel[i], u[i]});
   }
 
-  // 4) Steady-state error: mean of last 0.5s inside [step_time, t_end)
-  const double window = 0.5;
-  const double t0 = std::max(step_time, t_end - window);
+  Metrics result() const {
+    Metrics m = m_;
 
-  double sum = 0.0; int cnt = 0;
-  for (const auto& s : log) {
-    if (s.t < t0 || s.t >= t_end) continue;
-    sum += s.vel; cnt++;
-  }
-  if (cnt > 0) {
-    const double mean = sum / cnt;
-    m.ss_error = mean - v1;
-  }
+    const double mag = (delta_ >= 0.0) ? (peak_ - v1_) : (v1_ - peak_);
+    if (std::abs(delta_) > 1e-9) m.overshoot_pct = std::max(0.0, mag / std::abs(delta_) * 100.0);
+    else m.overshoot_pct = 0.0;
 
-  // 5) Max contiguous saturation duration inside [step_time, t_end)
-  double current = 0.0, best = 0.0;
-  double last_t = std::numeric_limits<double>::quiet_NaN();
+    if (!std::isnan(settle_t_)) m.settling_time = settle_t_ - step_time_;
 
-  for (const auto& s : log) {
-    if (s.t < step_time || s.t >= t_end) continue;
-    const bool sat = (std::abs(s.u) >= 0.999);
+    if (ss_cnt_ > 0) m.ss_error = ss_sum_ / ss_cnt_ - v1_;
 
-    if (sat) {
-      if (std::isfinite(last_t)) current += (s.t - last_t);
-    } else {
-      best = std::max(best, current);
-      current = 0.0;
-    }
-    last_t = s.t;
+    m.max_sat_duration = std::max(sat_best_, sat_cur_);
+    return m;
   }
-  best = std::max(best, current);
-  m.max_sat_duration = best;
 
-  return m;
+private:
+  double step_time_, t_end_, v1_, delta_;
+  double thr_;
+  double peak_;
+  double lo_, hi_;
+  double ss_t0_;
+
+  Metrics m_{};
+  double settle_t_ = std::numeric_limits<double>::quiet_NaN();
+  double ss_sum_ = 0.0;
+  int ss_cnt_ = 0;
+  double sat_cur_ = 0.0, sat_best_ = 0.0;
+  double last_t_ = std::numeric_limits<double>::quiet_NaN();
+};
+
+// 로그 전체가 있을 때 (기존 API 유지)
+inline Metrics compute_metrics_step(const std::vector<Sample>& log,
+                                    double step_time,
+                                    double t_end,
+                                    double v0,
+                                    double v1) {
+  StepMetricsAccumulator acc(step_time, t_end, v0, v1);
+  for (const auto& s : log) acc.add(s);
+  return acc.result();
+}
+
+// column 배열 버전 (ColumnarTraceReader -> parse 없이)
+inline Metrics compute_metrics_step(const double* t, const double* target,
+                                    const double* vel, const double* u, std::size_t n,
+                                    double step_time, double t_end, double v0, double v1) {
+  StepMetricsAccumulator acc(step_time, t_end, v0, v1);
+  acc.add_columns(t, target, vel, u, n);
+  return acc.result();
 }
 
 
-inline void print_step_report(const StepResult& r) {
-  std::cout << "\n[" << r.name << "]\n";
-  std::cout << "Rise/Fall(90%)   : " << r.m.rise_time << " s   (" << (r.pf.pr01_rise ? "PASS" : "FAIL") << ")\n";
-  std::cout << "Overshoot/Unders : " << r.m.overshoot_pct << " %   (" << (r.pf.pr02_over ? "PASS" : "FAIL") << ")\n";
-  std::cout << "Settling Time    : " << r.m.settling_time << " s   (" << (r.pf.pr03_settle ? "PASS" : "FAIL") << ")\n";
-  std::cout << "Steady-State Err : " << r.m.ss_error << "     (" << (r.pf.pr04_ss ? "PASS" : "FAIL") << ")\n";
-  std::cout << "Sat Duration     : " << r.m.max_sat_duration << " s (" << (r.pf.pr05_sat ? "PASS" : "FAIL") << ")\n";
+inline bool step_passed(const PassFail& pf) {
+  return pf.pr01_rise && pf.pr02_over && pf.pr03_settle && pf.pr04_ss && pf.pr05_sat;
+}
 
-  const bool all = r.pf.pr01_rise && r.pf.pr02_over && r.pf.pr03_settle && r.pf.pr04_ss && r.pf.pr05_sat;
-  std::cout << "RESULT: " << (all ? "✅ PASS" : "❌ FAIL") << "\n";
+inline void print_step_report(const StepResult& r, std::ostream& os = std::cout) {
+  os << "\n[" << r.name << "]\n";
+  os << "Rise/Fall(90%)   : " << r.m.rise_time << " s   (" << (r.pf.pr01_rise ? "PASS" : "FAIL") << ")\n";
+  os << "Overshoot/Unders : " << r.m.overshoot_pct << " %   (" << (r.pf.pr02_over ? "PASS" : "FAIL") << ")\n";
+  os << "Settling Time    : " << r.m.settling_time << " s   (" << (r.pf.pr03_settle ? "PASS" : "FAIL") << ")\n";
+  os << "Steady-State Err : " << r.m.ss_error << "     (" << (r.pf.pr04_ss ? "PASS" : "FAIL") << ")\n";
+  os << "Sat Duration     : " << r.m.max_sat_duration << " s (" << (r.pf.pr05_sat ? "PASS" : "FAIL") << ")\n";
+  os << "RESULT: " << (step_passed(r.pf) ? "✅ PASS" : "❌ FAIL") << "\n";
 }
 
 inline void print_suite_summary(const std::vector<StepResult>& results) {
@@ -0,0 +1,62 @@
+#pragma once
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// =====================
+// 시나리오/테스트 case 등록소
+// - case마다 SCENARIO_CASE(suite, name, fn)로 스스로 등록 (정적 초기화)
+// - fn(os): case 안에서 core/plant를 직접 만들어 씀 (case끼리 상태 공유 없음)
+//   출력은 os로만 (병렬 실행 시 case별로 모았다가 등록 순서대로 출력)
+// - 실행 환경이 없으면 (vcan0, 요청한 ISA 등) `return scenario_skip(os, "이유");` -> SKIP
+// =====================
+
+struct ScenarioCase {
+    std::string suite;
+    std::string name;
+    std::function<bool(std::ostream&)> run;
+
+    std::string full_name() const { return suite + "/" + name; }
+};
+
+class ScenarioRegistry {
+public:
+    static ScenarioRegistry& instance() {
+        static ScenarioRegistry r;
+        return r;
+    }
+
+    void add(std::string suite, std::string name, std::function<bool(std::ostream&)> fn) {
+        cases_.push_back(ScenarioCase{std::move(suite), std::move(name), std::move(fn)});
+    }
+
+    const std::vector<ScenarioCase>& cases() const { return cases_; }
+
+private:
+    std::vector<ScenarioCase> cases_;
+};
+
+// 지금 thread에서 도는 case가 scenario_skip을 불렀는지 (runner가 case마다 초기화)
+inline bool& scenario_skip_flag() {
+    thread_local bool skipped = false;
+    return skipped;
+}
+
+inline bool scenario_skip(std::ostream& os, const std::string& reason) {
+    scenario_skip_flag() = true;
+    os << "SKIP (" << reason << ")\n";
+    os << "RESULT: SKIP\n\n";
+    return true;
+}
+
+struct ScenarioRegistrar {
+    ScenarioRegistrar(const char* suite, const char* name, std::function<bool(std::ostream&)> fn) {
+        ScenarioRegistry::instance().add(suite, name, std::move(fn));
+    }
+};
+
+#define SCENARIO_CONCAT_(a, b) a##b
+#define SCENARIO_CONCAT(a, b) SCENARIO_CONCAT_(a, b)
+#define SCENARIO_CASE(suite, name, fn) \
+    static const ScenarioRegistrar SCENARIO_CONCAT(scenario_registrar_, __LINE__)(suite, name, fn)
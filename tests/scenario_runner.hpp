@@ -0,0 +1,259 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scenario_registry.hpp"
+#include "../include/util/work_stealing_pool.hpp"
+
+// =====================
+// 등록된 case를 thread pool에서 병렬 실행
+// - --shard i/n : 등록 순서 index % n == i 인 case만 (CI에서 n개 job으로 나눌 때)
+// - --filter STR: "suite/name"에 STR이 들어간 case만 (쉼표로 여러 개 = OR)
+// - --threads N : 기본 hardware_concurrency
+// - --junit PATH / --json PATH : 결과 파일
+// - --list      : 실행 없이 선택된 case 이름만
+// - --timelines DIR: 파일 시나리오(.tl) 디렉터리 (등록은 scenario_main의 prepare에서)
+// - case 출력은 case별 버퍼에 모았다가 등록 순서대로 찍음 (병렬이어도 안 섞임)
+// =====================
+
+struct ScenarioRunOptions {
+    unsigned shard_index = 0;
+    unsigned shard_count = 1;
+    std::string filter;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string junit_path;
+    std::string json_path;
+    bool list = false;
+    std::string timeline_dir = "tests/scenarios/timelines";
+};
+
+struct ScenarioOutcome {
+    const ScenarioCase* sc = nullptr;
+    bool pass = false;
+    bool skipped = false;   // scenario_skip (pass도 true, 실패로 안 셈)
+    double seconds = 0.0;
+    std::string log;
+};
+
+inline bool parse_scenario_args(int argc, char** argv, ScenarioRunOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--shard" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%u/%u", &opt.shard_index, &opt.shard_count) != 2 ||
+                opt.shard_count == 0 || opt.shard_index >= opt.shard_count) return false;
+        }
+        else if (a == "--filter" && i + 1 < argc)   opt.filter = argv[++i];
+        else if (a == "--threads" && i + 1 < argc)  opt.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--junit" && i + 1 < argc)    opt.junit_path = argv[++i];
+        else if (a == "--json" && i + 1 < argc)     opt.json_path = argv[++i];
+        else if (a == "--timelines" && i + 1 < argc) opt.timeline_dir = argv[++i];
+        else if (a == "--list")                     opt.list = true;
+        else return false;
+    }
+    return true;
+}
+
+inline bool scenario_selected(const ScenarioCase& c, std::size_t index, const ScenarioRunOptions& opt) {
+    if (index % opt.shard_count != opt.shard_index) return false;
+    if (opt.filter.empty()) return true;
+    const std::string full = c.full_name();
+    std::size_t pos = 0;
+    while (pos <= opt.filter.size()) {
+        const std::size_t comma = opt.filter.find(',', pos);
+        const std::string term = opt.filter.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        if (!term.empty() && full.find(term) != std::string::npos) return true;
+        if (comma == std::string::npos) break;
+        pos = comma + 1;
+    }
+    return false;
+}
+
+inline std::vector<const ScenarioCase*> select_scenarios(const ScenarioRegistry& reg, const ScenarioRunOptions& opt) {
+    std::vector<const ScenarioCase*> out;
+    const auto& all = reg.cases();
+    for (std::size_t i = 0; i < all.size(); ++i)
+        if (scenario_selected(all[i], i, opt)) out.push_back(&all[i]);
+    return out;
+}
+
+inline std::vector<ScenarioOutcome> run_scenarios(const std::vector<const ScenarioCase*>& cases, unsigned threads) {
+    std::vector<ScenarioOutcome> out(cases.size());
+    WorkStealingPool pool(threads);
+    pool.parallel_for(cases.size(), 1, [&](std::size_t i) {
+        ScenarioOutcome& o = out[i];
+        o.sc = cases[i];
+        std::ostringstream os;
+        const auto t0 = std::chrono::steady_clock::now();
+        scenario_skip_flag() = false;
+        try {
+            o.pass = cases[i]->run(os);
+        } catch (const std::exception& e) {
+            os << "exception: " << e.what() << "\n";
+            o.pass = false;
+        }
+        o.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        o.skipped = o.pass && scenario_skip_flag();
+        o.log = os.str();
+    });
+    return out;
+}
+
+inline const char* scenario_status(const ScenarioOutcome& o) {
+    return o.skipped ? "SKIP" : (o.pass ? "PASS" : "FAIL");
+}
+
+inline void print_scenario_summary(const std::vector<ScenarioOutcome>& out, double wall_s, std::ostream& os) {
+    std::size_t failed = 0, skipped = 0;
+    os << "\n==============================\n";
+    os << "[SUITE SUMMARY]\n";
+    os << "------------------------------\n";
+    for (const auto& o : out) {
+        if (!o.pass) ++failed;
+        if (o.skipped) ++skipped;
+        os << o.sc->full_name() << " : " << scenario_status(o)
+           << " (" << std::fixed << std::setprecision(3) << o.seconds << " s)\n" << std::defaultfloat;
+    }
+    os << "------------------------------\n";
+    os << out.size() - failed - skipped << "/" << out.size() << " passed, " << skipped << " skipped, wall " << std::fixed << std::setprecision(3)
+       << wall_s << " s\n" << std::defaultfloat;
+    os << "SUITE RESULT: " << (failed == 0 ? "✅ PASS" : "❌ FAIL") << "\n";
+    os << "==============================\n\n";
+}
+
+// ---------- 결과 파일 ----------
+
+inline std::string scenario_xml_escape(const std::string& s) {
+    std::string r;
+    r.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+            case '&': r += "&amp;"; break;
+            case '<': r += "&lt;"; break;
+            case '>': r += "&gt;"; break;
+            case '"': r += "&quot;"; break;
+            default: r += c;
+        }
+    }
+    return r;
+}
+
+inline std::string scenario_json_escape(const std::string& s) {
+    std::string r;
+    r.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') { r += '\\'; r += c; }
+        else if (c == '\n') r += "\\n";
+        else if (static_cast<unsigned char>(c) < 0x20) r += ' ';
+        else r += c;
+    }
+    return r;
+}
+
+// suite별 <testsuite>, case 로그는 <system-out>
+inline bool write_junit(const std::string& path, const std::vector<ScenarioOutcome>& out, double wall_s) {
+    std::ofstream f(path);
+    if (!f) return false;
+    std::size_t failed = 0, skipped = 0;
+    for (const auto& o : out) { failed += o.pass ? 0 : 1; skipped += o.skipped ? 1 : 0; }
+
+    f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    f << "<testsuites name=\"controller_tests\" tests=\"" << out.size() << "\" failures=\"" << failed
+      << "\" skipped=\"" << skipped << "\" time=\"" << wall_s << "\">\n";
+
+    std::vector<std::string> suites;
+    for (const auto& o : out) {
+        bool seen = false;
+        for (const auto& s : suites) seen = seen || s == o.sc->suite;
+        if (!seen) suites.push_back(o.sc->suite);
+    }
+    for (const auto& s : suites) {
+        std::size_t n = 0, nf = 0, ns = 0;
+        double t = 0.0;
+        for (const auto& o : out) {
+            if (o.sc->suite != s) continue;
+            ++n; nf += o.pass ? 0 : 1; ns += o.skipped ? 1 : 0; t += o.seconds;
+        }
+        f << "  <testsuite name=\"" << scenario_xml_escape(s) << "\" tests=\"" << n
+          << "\" failures=\"" << nf << "\" skipped=\"" << ns << "\" time=\"" << t << "\">\n";
+        for (const auto& o : out) {
+            if (o.sc->suite != s) continue;
+            f << "    <testcase classname=\"" << scenario_xml_escape(s) << "\" name=\""
+              << scenario_xml_escape(o.sc->name) << "\" time=\"" << o.seconds << "\">\n";
+            if (!o.pass) f << "      <failure message=\"FAIL\"/>\n";
+            if (o.skipped) f << "      <skipped/>\n";
+            f << "      <system-out>" << scenario_xml_escape(o.log) << "</system-out>\n";
+            f << "    </testcase>\n";
+        }
+        f << "  </testsuite>\n";
+    }
+    f << "</testsuites>\n";
+    return static_cast<bool>(f);
+}
+
+// case당 한 줄
+inline bool write_json(const std::string& path, const std::vector<ScenarioOutcome>& out,
+                       double wall_s, const ScenarioRunOptions& opt) {
+    std::ofstream f(path);
+    if (!f) return false;
+    std::size_t failed = 0, skipped = 0;
+    for (const auto& o : out) { failed += o.pass ? 0 : 1; skipped += o.skipped ? 1 : 0; }
+
+    f << "{\"shard\": \"" << opt.shard_index << "/" << opt.shard_count << "\", "
+      << "\"filter\": \"" << scenario_json_escape(opt.filter) << "\", "
+      << "\"total\": " << out.size() << ", \"failed\": " << failed << ", \"skipped\": " << skipped << ", \"seconds\": " << wall_s << ",\n";
+    f << " \"cases\": [\n";
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const auto& o = out[i];
+        f << "  {\"suite\": \"" << scenario_json_escape(o.sc->suite) << "\", \"name\": \""
+          << scenario_json_escape(o.sc->name) << "\", \"pass\": " << (o.pass ? "true" : "false")
+          << ", \"skipped\": " << (o.skipped ? "true" : "false") << ", \"seconds\": " << o.seconds << "}" << (i + 1 < out.size() ? "," : "") << "\n";
+    }
+    f << " ]}\n";
+    return static_cast<bool>(f);
+}
+
+// test_runner main: (runtime 등록) -> 선택 -> 병렬 실행 -> 출력/파일, 전부 PASS면 0
+// prepare(opt): 인자 파싱 뒤, 선택 전에 불림 (파일에서 읽는 case를 registry에 추가)
+inline int scenario_main(int argc, char** argv,
+                         const std::function<void(const ScenarioRunOptions&)>& prepare = {}) {
+    ScenarioRunOptions opt;
+    if (!parse_scenario_args(argc, argv, opt)) {
+        std::cerr << "usage: controller_tests [--shard I/N] [--filter STR[,STR..]] [--threads N]\n"
+                     "                        [--junit PATH] [--json PATH] [--timelines DIR] [--list]\n";
+        return 2;
+    }
+    if (prepare) prepare(opt);
+
+    const auto cases = select_scenarios(ScenarioRegistry::instance(), opt);
+    if (opt.list) {
+        for (const auto* c : cases) std::cout << c->full_name() << "\n";
+        return 0;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto out = run_scenarios(cases, opt.threads);
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    bool all_ok = true;
+    for (const auto& o : out) {
+        std::cout << o.log;
+        all_ok = all_ok && o.pass;
+    }
+    print_scenario_summary(out, wall_s, std::cout);
+
+    if (!opt.junit_path.empty() && !write_junit(opt.junit_path, out, wall_s))
+        std::cerr << "cannot write " << opt.junit_path << "\n";
+    if (!opt.json_path.empty() && !write_json(opt.json_path, out, wall_s, opt))
+        std::cerr << "cannot write " << opt.json_path << "\n";
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../include/main_inputs_outputs.hpp"
+#include "../../src/controller_core.hpp"
+
+// =====================
+// TimelineScenario: 파일(.tl)에서 읽는 시나리오 (rebuild 없이 case 추가)
+// - 형식: 한 줄에 하나, '#' 뒤는 주석
+//     name   STEP 0.0 -> 1.0          표시 이름 (줄 끝까지)
+//     end    400                      end_tick
+//     step   100 0.0 1.0              (선택) drive step metrics: step_tick v0 v1
+//     init   drive_enable 1           tick 0 전에 Inputs{}에 덮어쓸 값
+//     100    target_velocity 1.0      tick 100부터 이 값 유지 (다음 event까지)
+//     expect 101 motor_cmd 0 [TOL]    (선택) tick 101 step 직후 출력 검사 (기본 TOL 1e-9)
+// - load 시 event를 tick 순으로 정렬(같은 tick은 파일 순서)해 한 배열로 두고
+//   tick별 시작 index 표를 만들어 둠 -> apply(tick)은 표 조회 + 그 tick event만 적용
+//   (tick마다 구간 비교 없음, const라 ScenarioInputSource로 그대로 재생)
+// - event는 값을 "유지"하는 의미: apply는 0..end_tick-1 순서로 불린다고 가정
+// =====================
+
+enum class TimelineSignal : std::uint8_t {
+    DriveEnable, LiftRequest, DumpRequest, OperatorAck, EstopButton,
+    BatteryOk, CommsOk,
+    CanTimeout, CriticalDtc, LiftTimeout, LiftSensorError, DumpTimeout, DumpSensorError,
+    NoActiveFault, LiftComplete, DumpComplete,
+    TargetVelocity, ScenarioId, StepId, StepActive,
+    Count
+};
+
+inline constexpr const char* TIMELINE_SIGNALS[] = {
+    "drive_enable", "lift_request", "dump_request", "operator_ack", "estop_button",
+    "battery_ok", "comms_ok",
+    "can_timeout", "critical_dtc", "lift_timeout", "lift_sensor_error", "dump_timeout", "dump_sensor_error",
+    "no_active_fault", "lift_complete", "dump_complete",
+    "target_velocity", "scenario_id", "step_id", "step_active",
+};
+static_assert(sizeof(TIMELINE_SIGNALS) / sizeof(TIMELINE_SIGNALS[0]) ==
+              static_cast<std::size_t>(TimelineSignal::Count), "signal name table");
+
+inline void apply_timeline_signal(TimelineSignal s, double v, Inputs& in) {
+    const bool b = v != 0.0;
+    switch (s) {
+        case TimelineSignal::DriveEnable:     in.drive_enable = b; break;
+        case TimelineSignal::LiftRequest:     in.lift_request = b; break;
+        case TimelineSignal::DumpRequest:     in.dump_request = b; break;
+        case TimelineSignal::OperatorAck:     in.operator_ack = b; break;
+        case TimelineSignal::EstopButton:     in.estop_button = b; break;
+        case TimelineSignal::BatteryOk:       in.battery_ok = b; break;
+        case TimelineSignal::CommsOk:         in.comms_ok = b; break;
+        case TimelineSignal::CanTimeout:      in.can_timeout = b; break;
+        case TimelineSignal::CriticalDtc:     in.critical_dtc = b; break;
+        case TimelineSignal::LiftTimeout:     in.lift_timeout = b; break;
+        case TimelineSignal::LiftSensorError: in.lift_sensor_error = b; break;
+        case TimelineSignal::DumpTimeout:     in.dump_timeout = b; break;
+        case TimelineSignal::DumpSensorError: in.dump_sensor_error = b; break;
+        case TimelineSignal::NoActiveFault:   in.no_active_fault = b; break;
+        case TimelineSignal::LiftComplete:    in.lift_complete = b; break;
+        case TimelineSignal::DumpComplete:    in.dump_complete = b; break;
+        case TimelineSignal::TargetVelocity:  in.target_velocity = v; break;
+        case TimelineSignal::ScenarioId:      in.scenario_id = static_cast<int>(v); break;
+        case TimelineSignal::StepId:          in.step_id = static_cast<int>(v); break;
+        case TimelineSignal::StepActive:      in.step_active = b; break;
+        case TimelineSignal::Count:           break;
+    }
+}
+
+// expect 대상 (step 직후 출력 / debug / plant 속도)
+enum class TimelineProbe : std::uint8_t {
+    MotorCmd, DriveCmd, LiftCmd, DumpCmd, FaultCode, FaultLatched, State, Velocity,
+    Count
+};
+
+inline constexpr const char* TIMELINE_PROBES[] = {
+    "motor_cmd", "drive_cmd", "lift_cmd", "dump_cmd", "fault_code", "fault_latched", "state", "velocity",
+};
+static_assert(sizeof(TIMELINE_PROBES) / sizeof(TIMELINE_PROBES[0]) ==
+              static_cast<std::size_t>(TimelineProbe::Count), "probe name table");
+
+inline double timeline_probe(TimelineProbe p, const Outputs& out, const ControllerDebug& dbg, const Inputs& in) {
+    switch (p) {
+        case TimelineProbe::MotorCmd:     return out.motor_cmd;
+        case TimelineProbe::DriveCmd:     return out.drive_cmd ? 1.0 : 0.0;
+        case TimelineProbe::LiftCmd:      return out.lift_cmd ? 1.0 : 0.0;
+        case TimelineProbe::DumpCmd:      return out.dump_cmd ? 1.0 : 0.0;
+        case TimelineProbe::FaultCode:    return out.fault_code;
+        case TimelineProbe::FaultLatched: return dbg.fault_latched ? 1.0 : 0.0;
+        case TimelineProbe::State:        return dbg.state;
+        case TimelineProbe::Velocity:     return in.velocity;
+        case TimelineProbe::Count:        break;
+    }
+    return 0.0;
+}
+
+struct TimelineEvent {
+    std::int32_t tick = 0;
+    TimelineSignal signal = TimelineSignal::Count;
+    double value = 0.0;
+};
+
+struct TimelineExpect {
+    std::int32_t tick = 0;
+    TimelineProbe probe = TimelineProbe::Count;
+    double value = 0.0;
+    double tol = 1e-9;
+};
+
+class TimelineScenario {
+public:
+    // 성공 시 true, 실패 시 err = "origin:line: 이유"
+    bool parse(std::istream& is, const std::string& origin, std::string& err) {
+        *this = TimelineScenario{};
+        std::vector<TimelineEvent> events;
+        std::string line;
+        int lineno = 0;
+        auto fail = [&](const std::string& why) {
+            err = origin + ":" + std::to_string(lineno) + ": " + why;
+            return false;
+        };
+
+        while (std::getline(is, line)) {
+            ++lineno;
+            const std::size_t hash = line.find('#');
+            if (hash != std::string::npos) line.resize(hash);
+            std::istringstream ls(line);
+            std::string key;
+            if (!(ls >> key)) continue;
+
+            if (key == "name") {
+                std::getline(ls >> std::ws, name_);
+                while (!name_.empty() && std::isspace(static_cast<unsigned char>(name_.back()))) name_.pop_back();
+            } else if (key == "end") {
+                if (!(ls >> end_tick_) || end_tick_ <= 0) return fail("bad end tick");
+            } else if (key == "step") {
+                if (!(ls >> step_tick_ >> v0_ >> v1_) || step_tick_ < 0) return fail("step needs: tick v0 v1");
+                has_step_ = true;
+            } else if (key == "init") {
+                TimelineEvent e;
+                if (!parse_signal_(ls, e)) return fail("init needs: signal value");
+                init_.push_back(e);
+            } else if (key == "expect") {
+                TimelineExpect x;
+                std::string probe;
+                if (!(ls >> x.tick >> probe) || !parse_value_(ls, x.value)) return fail("expect needs: tick probe value [tol]");
+                const int p = find_name_(TIMELINE_PROBES, static_cast<int>(TimelineProbe::Count), probe);
+                if (p < 0) return fail("unknown probe '" + probe + "'");
+                x.probe = static_cast<TimelineProbe>(p);
+                std::string tol;
+                if ((ls >> tol) && !to_value_(tol, x.tol)) return fail("bad tol '" + tol + "'");
+                expects_.push_back(x);
+            } else {
+                TimelineEvent e;
+                char* endp = nullptr;
+                const long tick = std::strtol(key.c_str(), &endp, 10);
+                if (*endp != '\0' || tick < 0) return fail("unknown directive '" + key + "'");
+                if (!parse_signal_(ls, e)) return fail("event needs: tick signal value");
+                e.tick = static_cast<std::int32_t>(tick);
+                events.push_back(e);
+            }
+            std::string extra;
+            if (key != "name" && (ls >> extra)) return fail("trailing '" + extra + "'");
+        }
+
+        if (end_tick_ <= 0) return fail("missing 'end'");
+        if (name_.empty()) name_ = origin;
+        for (const auto& e : events)
+            if (e.tick >= end_tick_) return fail("event tick " + std::to_string(e.tick) + " >= end");
+        for (const auto& x : expects_)
+            if (x.tick < 0 || x.tick >= end_tick_) return fail("expect tick " + std::to_string(x.tick) + " out of range");
+
+        // tick 순 정렬 (같은 tick 안은 파일 순서 유지) + tick별 시작 index
+        std::stable_sort(events.begin(), events.end(),
+                         [](const TimelineEvent& a, const TimelineEvent& b) { return a.tick < b.tick; });
+        std::stable_sort(expects_.begin(), expects_.end(),
+                         [](const TimelineExpect& a, const TimelineExpect& b) { return a.tick < b.tick; });
+        events_ = std::move(events);
+        first_.assign(static_cast<std::size_t>(end_tick_) + 1, 0);
+        std::size_t i = 0;
+        for (int t = 0; t <= end_tick_; ++t) {
+            while (i < events_.size() && events_[i].tick < t) ++i;
+            first_[static_cast<std::size_t>(t)] = static_cast<std::uint32_t>(i);
+        }
+        return true;
+    }
+
+    bool load(const std::string& path, std::string& err) {
+        std::ifstream f(path);
+        if (!f) {
+            err = "cannot open " + path;
+            return false;
+        }
+        return parse(f, path, err);
+    }
+
+    // ---- 시나리오 인터페이스 (ScenarioInputSource / run_drive_case 호환) ----
+    const char* name() const { return name_.c_str(); }
+    int end_tick() const { return end_tick_; }
+    int step_tick() const { return step_tick_; }
+    double v0() const { return v0_; }
+    double v1() const { return v1_; }
+
+    void init(Inputs& in) const {
+        in = Inputs{};
+        for (const auto& e : init_) apply_timeline_signal(e.signal, e.value, in);
+    }
+
+    void apply(int tick, Inputs& in) const {
+        if (tick < 0 || tick >= end_tick_) return;
+        const std::uint32_t b = first_[static_cast<std::size_t>(tick)];
+        const std::uint32_t e = first_[static_cast<std::size_t>(tick) + 1];
+        for (std::uint32_t i = b; i < e; ++i) apply_timeline_signal(events_[i].signal, events_[i].value, in);
+    }
+
+    bool has_step() const { return has_step_; }
+    const std::vector<TimelineEvent>& events() const { return events_; }
+    const std::vector<TimelineExpect>& expects() const { return expects_; }
+
+private:
+    static int find_name_(const char* const* names, int n, const std::string& s) {
+        for (int i = 0; i < n; ++i)
+            if (s == names[i]) return i;
+        return -1;
+    }
+
+    static bool parse_value_(std::istream& ls, double& v) {
+        std::string tok;
+        return (ls >> tok) && to_value_(tok, v);
+    }
+
+    static bool to_value_(const std::string& tok, double& v) {
+        if (tok == "true" || tok == "on")   { v = 1.0; return true; }
+        if (tok == "false" || tok == "off") { v = 0.0; return true; }
+        char* endp = nullptr;
+        v = std::strtod(tok.c_str(), &endp);
+        return *endp == '\0' && std::isfinite(v);
+    }
+
+    static bool parse_signal_(std::istream& ls, TimelineEvent& e) {
+        std::string sig;
+        if (!(ls >> sig)) return false;
+        const int s = find_name_(TIMELINE_SIGNALS, static_cast<int>(TimelineSignal::Count), sig);
+        if (s < 0) return false;
+        e.signal = static_cast<TimelineSignal>(s);
+        return parse_value_(ls, e.value);
+    }
+
+    std::string name_;
+    int end_tick_ = 0;
+    bool has_step_ = false;
+    int step_tick_ = 0;
+    double v0_ = 0.0;
+    double v1_ = 0.0;
+
+    std::vector<TimelineEvent> init_;
+    std::vector<TimelineEvent> events_;       // tick 순
+    std::vector<std::uint32_t> first_;        // first_[t] = tick t 첫 event index (크기 end+1)
+    std::vector<TimelineExpect> expects_;     // tick 순
+};
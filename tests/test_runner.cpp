@@ -1,65 +1,64 @@
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
 
 #include "../src/controller_core.hpp"
+#include "../src/controller_fleet.hpp"
+#include "../include/pid_batch.hpp"
+#include "../src/drivers/fakecan_bus.hpp"
+#include "../include/util/static_ring.hpp"
+#include "../src/drivers/fakecan_network.hpp"
+#include "../src/drivers/fakecan_codec.hpp"
+#include "vehicle_dbc.hpp"   // make가 can/vehicle.dbc에서 생성 (gen/)
+#include "../src/instrumentation/step_profiler.hpp"
+#include "../src/rt/periodic_executive.hpp"
+#include "../runtime/can_io_thread.hpp"
+#include "../src/drivers/socketcan_io.hpp"
+#include "../include/io/mux_input_source.hpp"
+#include "../include/io/log_sink.hpp"
+#include "../src/trace/columnar_trace.hpp"
+#include "../include/io/scenario_input_source.hpp"
+#include "../src/drivers/can_capture.hpp"
+#include "../runtime/can_replay.hpp"
 #include "../sim/plant.hpp"
+#include "../sim/vehicle_plant.hpp"
+#include "../sim/plant_batch.hpp"
 
-#include "metrics/drive_metrics.hpp"
+#include "test_runner.hpp"
+#include "scenario_runner.hpp"
 #include "scenarios/drive_step_0_1.hpp"
 #include "scenarios/drive_step_1_03.hpp"
 #include "scenarios/drive_step_03_08.hpp"
 #include "scenarios/fault_estop.hpp"
 #include "scenarios/comms_lost_latch.hpp"
-
-static constexpr double DT_S = 0.01;
+#include "scenarios/timeline_scenario.hpp"
 
 // =======================
-// Drive scenario runner
+// Drive: step 응답 (case마다 core/plant 새로 생성)
 // =======================
 template <typename DriveScenario>
-static StepResult run_drive_case(const DriveScenario& sc,
-                                 ControllerCore& core,
-                                 Plant& plant) {
-  Inputs in{};
-  Outputs out{};
-
-  sc.init(in);
-
-  std::vector<Sample> log;
-  log.reserve(sc.end_tick() + 10);
-
-  for (int tick = 0; tick < sc.end_tick(); ++tick) {
-    sc.apply(tick, in);          // command 생성
-    out = core.step(in, DT_S);   // 제어기
-    plant.step(out, in, DT_S);   // plant + sensor
-
-    const double t = tick * DT_S;
-    log.push_back(Sample{
-      t,
-      in.target_velocity,
-      in.velocity,
-      out.motor_cmd
-    });
-  }
-
-  const double step_time = sc.step_tick() * DT_S;
-  const double end_time  = sc.end_tick()  * DT_S;
-
-  Metrics m = compute_metrics_step(
-    log, step_time, end_time, sc.v0(), sc.v1()
-  );
-
-  DriveCriteria crit;
-  PassFail pf = judge(m, crit);
-
-  return StepResult{sc.name(), m, pf};
+static bool run_drive_step_case(std::ostream& os) {
+  ControllerCore core;
+  Plant plant;
+  const StepResult r = run_drive_case(DriveScenario{}, core, plant);
+  print_step_report(r, os);
+  return step_passed(r.pf);
 }
+SCENARIO_CASE("drive", "step_0_1", run_drive_step_case<DriveStep_0_1>);
+SCENARIO_CASE("drive", "step_1_03", run_drive_step_case<DriveStep_1_03>);
+SCENARIO_CASE("drive", "step_03_08", run_drive_step_case<DriveStep_03_08>);
 
 // =======================
 // Fault: E-STOP
 // =======================
-static bool run_fault_estop_case() {
+static bool run_fault_estop_case(std::ostream& os) {
   ControllerCore core; core.reset();
   Plant plant;
   FaultEstop sc;
@@ -91,20 +90,21 @@ static bool run_fault_estop_case() {
     }
   }
 
-  std::cout << "\n[" << sc.name() << "]\n";
-  std::cout << "Cutoff <= 1 cycle : " << (cutoff_ok ? "PASS" : "FAIL") << "\n";
-  std::cout << "Cleared after ACK : " << (cleared_ok ? "PASS" : "FAIL") << "\n";
-  std::cout << "RESULT: "
+  os << "\n[" << sc.name() << "]\n";
+  os << "Cutoff <= 1 cycle : " << (cutoff_ok ? "PASS" : "FAIL") << "\n";
+  os << "Cleared after ACK : " << (cleared_ok ? "PASS" : "FAIL") << "\n";
+  os << "RESULT: "
             << ((cutoff_ok && cleared_ok) ? "✅ PASS" : "❌ FAIL")
             << "\n\n";
 
   return cutoff_ok && cleared_ok;
 }
+SCENARIO_CASE("fault", "estop_cutoff", run_fault_estop_case);
 
 // =======================
 // Fault: COMMS lost
 // =======================
-static bool run_comms_lost_case() {
+static bool run_comms_lost_case(std::ostream& os) {
   ControllerCore core; core.reset();
   Plant plant;
   CommsLostLatch sc;
@@ -134,54 +134,1710 @@ static bool run_comms_lost_case() {
     }
   }
 
-  std::cout << "\n[" << sc.name() << "]\n";
-  std::cout << "Fault latched seen : "
+  os << "\n[" << sc.name() << "]\n";
+  os << "Fault latched seen : "
             << (fault_latched_seen ? "PASS" : "FAIL") << "\n";
-  std::cout << "Cleared after ACK  : "
+  os << "Cleared after ACK  : "
             << (cleared_ok ? "PASS" : "FAIL") << "\n";
-  std::cout << "RESULT: "
+  os << "RESULT: "
             << ((fault_latched_seen && cleared_ok) ? "✅ PASS" : "❌ FAIL")
             << "\n\n";
 
   return fault_latched_seen && cleared_ok;
 }
+SCENARIO_CASE("fault", "comms_lost_latch", run_comms_lost_case);
+
+// =======================
+// Fleet: N개 ControllerCore와 bit 단위 동일성
+// =======================
+static bool same_bits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+static bool same_output(const Outputs& a, const Outputs& b) {
+  return a.drive_cmd == b.drive_cmd && a.lift_cmd == b.lift_cmd && a.dump_cmd == b.dump_cmd &&
+         same_bits(a.motor_cmd, b.motor_cmd) && a.fault_code == b.fault_code;
+}
+
+static bool same_debug(const ControllerDebug& a, const ControllerDebug& b) {
+  return a.state == b.state && a.fault_latched == b.fault_latched &&
+         a.comms_ok_filtered == b.comms_ok_filtered && a.fault_code == b.fault_code &&
+         same_bits(a.pid_dbg.error, b.pid_dbg.error) && same_bits(a.pid_dbg.integ, b.pid_dbg.integ) &&
+         same_bits(a.pid_dbg.u_unsat, b.pid_dbg.u_unsat) && same_bits(a.pid_dbg.u_sat, b.pid_dbg.u_sat) &&
+         a.pid_dbg.would_worsen == b.pid_dbg.would_worsen;
+}
+
+static bool run_fleet_equivalence_case(std::ostream& os) {
+  constexpr std::size_t N = 64;
+  constexpr int TICKS = 2000;
+
+  std::vector<ControllerCore> cores(N);
+  ControllerFleet fleet(N);
+  std::vector<Plant> plants(N);
+
+  std::vector<Inputs> in(N);
+  std::vector<Outputs> out_fleet(N);
+
+  // 슬롯마다 다른 랜덤 입력 (drive/lift/dump hold, estop/ack 펄스, comms 끊김, fault)
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> pct(0, 99);
+  std::uniform_real_distribution<double> vel(-1.5, 1.5);
+
+  bool ok = true;
+  int first_bad_tick = -1;
+
+  for (int tick = 0; tick < TICKS && ok; ++tick) {
+    for (std::size_t i = 0; i < N; ++i) {
+      Inputs& x = in[i];
+      x.operator_ack = (pct(rng) < 5);
+      if (pct(rng) < 2) x.drive_enable = !x.drive_enable;
+      if (pct(rng) < 2) x.lift_request = !x.lift_request;
+      if (pct(rng) < 2) x.dump_request = !x.dump_request;
+      x.lift_complete = (pct(rng) < 3);
+      x.dump_complete = (pct(rng) < 3);
+      x.estop_button = (pct(rng) < 1) ? !x.estop_button : x.estop_button;
+      x.comms_ok = (pct(rng) < 4) ? !x.comms_ok : x.comms_ok;
+      x.critical_dtc = (pct(rng) < 1);
+      x.no_active_fault = !x.critical_dtc;
+      if (pct(rng) < 3) x.target_velocity = vel(rng);
+    }
+
+    fleet.step(in, out_fleet, DT_S);
+
+    for (std::size_t i = 0; i < N; ++i) {
+      const Outputs o = cores[i].step(in[i], DT_S);
+      if (!same_output(o, out_fleet[i]) || !same_debug(cores[i].debug(), fleet.debug(i))) {
+        ok = false;
+        first_bad_tick = tick;
+        break;
+      }
+      plants[i].step(o, in[i], DT_S);
+    }
+  }
+
+  // 길이가 안 맞는 vector는 거절 (out/상태 그대로)
+  const ControllerDebug before = fleet.debug(0);
+  std::vector<Inputs> short_in(N - 1);
+  std::vector<Outputs> short_out;
+  const bool size_ok = !fleet.step(short_in, short_out, DT_S) && short_out.empty() &&
+                       same_debug(before, fleet.debug(0));
+
+  os << "\n[FLEET: SoA vs " << N << "x ControllerCore]\n";
+  os << "Bit-exact outputs : " << (ok ? "PASS" : "FAIL");
+  if (!ok) os << " (tick " << first_bad_tick << ")";
+  os << "\n";
+  os << "Size mismatch     : " << (size_ok ? "PASS" : "FAIL") << "\n";
+  ok = ok && size_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+
+  return ok;
+}
+SCENARIO_CASE("fleet", "bit_equivalence", run_fleet_equivalence_case);
+
+// =======================
+// Metrics: StepMetricsAccumulator(1-pass) == 기존 5-pass 구현 (bit 동일)
+// - 기존 O(n^2) settling 포함, 아래 compute_metrics_step_ref가 원본 그대로
+// - seed 고정 random log: 상승/하강 step, band 이탈-재진입 여러 번, 미정착, 미도달(NaN), 빈 log
+// =======================
+static Metrics compute_metrics_step_ref(const std::vector<Sample>& log,
+                                        double step_time,
+                                        double t_end,
+                                        double v0,
+                                        double v1) {
+  Metrics m{};
+  const double delta = v1 - v0;
+
+  // 1) 90% transition time
+  const double thr = v0 + 0.9 * delta;
+  for (size_t i = 0; i < log.size(); ++i) {
+    const auto& s = log[i];
+    if (s.t < step_time || s.t >= t_end) continue;
+
+    if (delta >= 0.0) {
+      if (s.vel >= thr) { m.rise_time = s.t - step_time; break; }
+    } else {
+      if (s.vel <= thr) { m.rise_time = s.t - step_time; break; }
+    }
+  }
+
+  // 2) Overshoot/undershoot (% of |delta|)
+  double peak = (delta >= 0.0) ? -1e9 : 1e9;
+  for (const auto& s : log) {
+    if (s.t < step_time || s.t >= t_end) continue;
+    if (delta >= 0.0) peak = std::max(peak, s.vel);
+    else              peak = std::min(peak, s.vel);
+  }
+  const double mag = (delta >= 0.0) ? (peak - v1) : (v1 - peak);
+  if (std::abs(delta) > 1e-9) m.overshoot_pct = std::max(0.0, mag / std::abs(delta) * 100.0);
+  else m.overshoot_pct = 0.0;
+
+  // 3) Settling time: must stay within band until t_end
+  const double band = 0.05 * std::max(1e-9, std::abs(v1));
+  const double lo = v1 - band;
+  const double hi = v1 + band;
+
+  for (size_t i = 0; i < log.size(); ++i) {
+    const auto& si = log[i];
+    if (si.t < step_time || si.t >= t_end) continue;
+
+    bool stays = true;
+    for (size_t j = i; j < log.size(); ++j) {
+      const auto& sj = log[j];
+      if (sj.t < step_time) continue;
+      if (sj.t >= t_end) break;
+      if (sj.vel < lo || sj.vel > hi) { stays = false; break; }
+    }
+    if (stays) { m.settling_time = si.t - step_time; break; }
+  }
+
+  // 4) Steady-state error: mean of last 0.5s inside [step_time, t_end)
+  const double window = 0.5;
+  const double t0 = std::max(step_time, t_end - window);
+
+  double sum = 0.0; int cnt = 0;
+  for (const auto& s : log) {
+    if (s.t < t0 || s.t >= t_end) continue;
+    sum += s.vel; cnt++;
+  }
+  if (cnt > 0) {
+    const double mean = sum / cnt;
+    m.ss_error = mean - v1;
+  }
+
+  // 5) Max contiguous saturation duration inside [step_time, t_end)
+  double current = 0.0, best = 0.0;
+  double last_t = std::numeric_limits<double>::quiet_NaN();
+
+  for (const auto& s : log) {
+    if (s.t < step_time || s.t >= t_end) continue;
+    const bool sat = (std::abs(s.u) >= 0.999);
+
+    if (sat) {
+      if (std::isfinite(last_t)) current += (s.t - last_t);
+    } else {
+      best = std::max(best, current);
+      current = 0.0;
+    }
+    last_t = s.t;
+  }
+  best = std::max(best, current);
+  m.max_sat_duration = best;
+
+  return m;
+}
+
+static bool same_metrics(const Metrics& a, const Metrics& b) {
+  return same_bits(a.rise_time, b.rise_time) && same_bits(a.overshoot_pct, b.overshoot_pct) &&
+         same_bits(a.settling_time, b.settling_time) && same_bits(a.ss_error, b.ss_error) &&
+         same_bits(a.max_sat_duration, b.max_sat_duration);
+}
+
+enum class MetricsShape { Settle, Reenter, NeverSettle, NeverRise, Count };
+
+// step 전후 구간 포함 log (t 단조 증가, dt 약간 흔들림)
+static std::vector<Sample> random_step_log(std::mt19937_64& rng, MetricsShape shape,
+                                           double step_time, double t_end, double v0, double v1) {
+  std::uniform_real_distribution<double> uni(0.0, 1.0);
+  const double band = 0.05 * std::max(1e-9, std::abs(v1));
+  const double tau = 0.05 + 0.5 * uni(rng);
+  const int excursions = 2 + static_cast<int>(uni(rng) * 4.0);   // Reenter: band 밖으로 2~5번
+
+  std::vector<Sample> log;
+  double t = 0.0;
+  int sat_left = 0;
+  while (t < t_end + 0.2) {
+    const double ts = std::max(0.0, t - step_time);
+    double vel = (t < step_time) ? v0 : v1 + (v0 - v1) * std::exp(-ts / tau);
+    switch (shape) {
+      case MetricsShape::Settle:
+        vel += 0.5 * band * (uni(rng) - 0.5);
+        break;
+      case MetricsShape::Reenter: {
+        vel += 0.5 * band * (uni(rng) - 0.5);
+        const double seg = (t_end - step_time) / (excursions + 1);
+        const double k = ts / seg;
+        if (t >= step_time && k >= 1.0 && k < excursions + 1 && k - std::floor(k) < 0.05)
+          vel += (uni(rng) < 0.5 ? -3.0 : 3.0) * band;
+        break;
+      }
+      case MetricsShape::NeverSettle:
+        vel += 3.0 * band * std::sin(2.0 * M_PI * 2.0 * t);
+        break;
+      case MetricsShape::NeverRise:
+        vel = v0 + 0.5 * (v1 - v0) * (1.0 - std::exp(-ts / tau)) * (t >= step_time);
+        break;
+      case MetricsShape::Count:
+        break;
+    }
+
+    if (sat_left == 0 && uni(rng) < 0.02) sat_left = 1 + static_cast<int>(uni(rng) * 40.0);
+    const double u = sat_left > 0 ? (uni(rng) < 0.5 ? -1.0 : 1.0) : 2.0 * uni(rng) - 1.0;
+    if (sat_left > 0) --sat_left;
+
+    log.push_back(Sample{t, t < step_time ? v0 : v1, vel, u});
+    t += 0.01 * (0.5 + uni(rng));
+  }
+  return log;
+}
+
+static bool run_metrics_reference_case(std::ostream& os) {
+  os << "\n[METRICS: 1-pass accumulator vs 5-pass reference]\n";
+  std::mt19937_64 rng(4);
+  std::uniform_real_distribution<double> vel(-5.0, 5.0);
+  std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+  int descending = 0, reentered = 0, unsettled = 0, never_rose = 0;
+  int mismatches = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const auto shape = static_cast<MetricsShape>(i % static_cast<int>(MetricsShape::Count));
+    const double step_time = 0.2 + uni(rng);
+    const double t_end = step_time + 1.0 + 3.0 * uni(rng);
+    const double v0 = vel(rng);
+    double v1 = vel(rng);
+    if (std::abs(v1 - v0) < 0.5) v1 = v0 + (v1 >= v0 ? 0.5 : -0.5);
+    const std::vector<Sample> log = random_step_log(rng, shape, step_time, t_end, v0, v1);
+
+    const Metrics ref = compute_metrics_step_ref(log, step_time, t_end, v0, v1);
+    const Metrics got = compute_metrics_step(log, step_time, t_end, v0, v1);
+    if (!same_metrics(ref, got)) ++mismatches;
+
+    descending += v1 < v0;
+    unsettled += std::isnan(ref.settling_time);
+    never_rose += std::isnan(ref.rise_time);
+
+    // band 안->밖 전환 횟수
+    if (shape == MetricsShape::Reenter) {
+      const double band = 0.05 * std::abs(v1);
+      int exits = 0;
+      bool inside = false;
+      for (const auto& s : log) {
+        if (s.t < step_time || s.t >= t_end) continue;
+        const bool in = s.vel >= v1 - band && s.vel <= v1 + band;
+        exits += inside && !in;
+        inside = in;
+      }
+      reentered += exits >= 2;
+    }
+  }
+
+  // 빈 log: rise/settle/ss는 NaN, 나머지는 기본값
+  const Metrics e_ref = compute_metrics_step_ref({}, 0.5, 3.0, 0.0, 1.0);
+  const Metrics e_got = compute_metrics_step(std::vector<Sample>{}, 0.5, 3.0, 0.0, 1.0);
+  const bool empty_ok = same_metrics(e_ref, e_got) && std::isnan(e_got.rise_time) &&
+                        std::isnan(e_got.settling_time) && std::isnan(e_got.ss_error);
+
+  // 각 shape이 실제로 만들어졌는지 (random이 빗나가면 비교가 의미 없음)
+  const bool coverage_ok = descending > 0 && reentered > 0 && unsettled > 0 && never_rose > 0;
+
+  const bool ok = mismatches == 0 && empty_ok && coverage_ok;
+  os << "logs=" << 2000 << " descending=" << descending << " reentered(>=2 exits)=" << reentered
+     << " never_settled=" << unsettled << " never_rose=" << never_rose << "\n";
+  os << "Fields equal (bit) : " << (mismatches == 0 ? "PASS" : "FAIL") << " (mismatches=" << mismatches << ")\n";
+  os << "Empty log          : " << (empty_ok ? "PASS" : "FAIL") << "\n";
+  os << "Shape coverage     : " << (coverage_ok ? "PASS" : "FAIL") << "\n";
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("metrics", "accumulator_vs_reference", run_metrics_reference_case);
+
+// =======================
+// PIDBatch: ISA별 경로 vs PID::compute
+// =======================
+static bool run_pid_batch_case(PIDBatch::Isa isa, const char* isa_name, std::ostream& os) {
+  constexpr std::size_t N = 37;   // SIMD 폭의 배수가 아닌 길이 (tail 경로 포함)
+  constexpr int TICKS = 1000;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> gain(0.0, 4.0);
+  std::uniform_real_distribution<double> vel(-2.0, 2.0);
+  std::uniform_int_distribution<int> pct(0, 99);
+
+  PIDBatch batch(N);
+  batch.set_isa(isa);
+  if (batch.isa() != isa) return scenario_skip(os, std::string("PIDBatch ") + isa_name + " unsupported on this CPU");
+  std::vector<PID> ref;
+  for (std::size_t k = 0; k < N; ++k) {
+    const double p = gain(rng);
+    const double i = (k % 5 == 0) ? 0.0 : gain(rng);   // ki == 0 분기 포함
+    const double d = (k % 3 == 0) ? 0.0 : gain(rng) * 0.1;
+    ref.emplace_back(p, i, d);
+    batch.set_gains(k, p, i, d);
+  }
+
+  std::vector<double> target(N), current(N), u(N, 0.0);
+  std::vector<std::uint8_t> active(N);
+
+  bool ok = true;
+  for (int tick = 0; tick < TICKS && ok; ++tick) {
+    for (std::size_t k = 0; k < N; ++k) {
+      if (pct(rng) < 2) { ref[k].reset(); batch.reset(k); }
+      active[k] = (pct(rng) < 80);
+      target[k] = vel(rng);
+      current[k] = vel(rng);
+    }
+
+    batch.compute(target.data(), current.data(), DT_S, u.data(), active.data());
+
+    for (std::size_t k = 0; k < N && ok; ++k) {
+      if (!active[k]) continue;
+      const double r = ref[k].compute(target[k], current[k], DT_S);
+      const PID::PIDDebug bd = batch.debug(k);
+      ok = same_bits(r, u[k]) && same_bits(ref[k].integ, batch.integ[k]) &&
+           same_bits(ref[k].dbg.error, bd.error) && same_bits(ref[k].dbg.u_unsat, bd.u_unsat) &&
+           same_bits(ref[k].dbg.u_sat, bd.u_sat) && ref[k].dbg.would_worsen == bd.would_worsen;
+    }
+  }
+
+  os << "[PIDBatch " << isa_name << "] bit-exact vs PID : " << (ok ? "PASS" : "FAIL") << "\n";
+  return ok;
+}
+SCENARIO_CASE("pid_batch", "scalar", [](std::ostream& os) { return run_pid_batch_case(PIDBatch::Isa::Scalar, "scalar", os); });
+SCENARIO_CASE("pid_batch", "sse2", [](std::ostream& os) { return run_pid_batch_case(PIDBatch::Isa::SSE2, "SSE2", os); });
+SCENARIO_CASE("pid_batch", "avx2", [](std::ostream& os) { return run_pid_batch_case(PIDBatch::Isa::AVX2, "AVX2", os); });
+
+// =======================
+// PlantBatch: ISA별 경로 vs Plant::step (lane마다 다른 max_accel/drag)
+// =======================
+static bool run_plant_batch_case(PlantBatch::Isa isa, const char* isa_name, std::ostream& os) {
+  constexpr std::size_t N = 37;   // SIMD 폭의 배수가 아닌 길이 (tail 경로 포함)
+  constexpr int TICKS = 2000;
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> accel(1.0, 3.0);
+  std::uniform_real_distribution<double> drag(0.6, 1.8);
+  std::uniform_real_distribution<double> cmd(-1.0, 1.0);
+  std::uniform_int_distribution<int> pct(0, 99);
+
+  PlantBatch batch(N);
+  batch.set_isa(isa);
+  if (batch.isa() != isa) return scenario_skip(os, std::string("PlantBatch ") + isa_name + " unsupported on this CPU");
+  std::vector<Plant> ref(N);
+  for (std::size_t k = 0; k < N; ++k) {
+    ref[k].max_accel = accel(rng);
+    ref[k].drag = drag(rng);
+    batch.set_params(k, ref[k].max_accel, ref[k].drag);
+  }
+
+  std::vector<double> u(N, 0.0);
+  bool ok = true;
+  for (int tick = 0; tick < TICKS && ok; ++tick) {
+    for (std::size_t k = 0; k < N; ++k) {
+      if (tick >= TICKS / 2 && k % 2 == 0) u[k] = (tick % 2) ? 0.0 : -0.0;   // 관성 주행 -> STOP_EPS 정지
+      else if (pct(rng) < 5) u[k] = cmd(rng);
+    }
+    batch.step(u.data(), DT_S);
+    for (std::size_t k = 0; k < N && ok; ++k) ok = same_bits(ref[k].step(u[k], DT_S), batch.vel[k]);
+  }
+
+  os << "[PlantBatch " << isa_name << "] bit-exact vs Plant : " << (ok ? "PASS" : "FAIL") << "\n";
+  return ok;
+}
+SCENARIO_CASE("plant_batch", "scalar", [](std::ostream& os) { return run_plant_batch_case(PlantBatch::Isa::Scalar, "scalar", os); });
+SCENARIO_CASE("plant_batch", "sse2", [](std::ostream& os) { return run_plant_batch_case(PlantBatch::Isa::SSE2, "SSE2", os); });
+SCENARIO_CASE("plant_batch", "avx2", [](std::ostream& os) { return run_plant_batch_case(PlantBatch::Isa::AVX2, "AVX2", os); });
+
+// =======================
+// FakeCanBus: 도착 순서 (시간순 + 동시간 FIFO) / 같은 seed 재현성
+// =======================
+static std::vector<CanFrame> run_bus_trace(uint64_t seed) {
+  FakeCanBus bus(FakeCanBus::Config{2000, 3000, 0.05, seed});
+  std::vector<CanFrame> got;
+
+  for (uint64_t t = 0; t < 200000; t += 1000) {
+    bus.poll(t);
+    for (uint32_t k = 0; k < 4; ++k) {
+      CanFrame f;
+      f.id = 0x100 + k;
+      f.t_us = t;
+      bus.push_rx(f);
+    }
+    while (auto rx = bus.pop_rx()) got.push_back(*rx);
+  }
+  bus.poll(UINT64_MAX);
+  while (auto rx = bus.pop_rx()) got.push_back(*rx);
+  return got;
+}
+
+static bool run_fakecan_bus_case(std::ostream& os) {
+  // 지터 없는 버스: 같은 도착 시간 -> push 순서 그대로
+  FakeCanBus fifo;
+  for (uint32_t k = 0; k < 8; ++k) { CanFrame f; f.id = k; fifo.push_rx(f); }
+  fifo.poll(0);
+  bool fifo_ok = true;
+  for (uint32_t k = 0; k < 8; ++k) {
+    auto rx = fifo.pop_rx();
+    fifo_ok = fifo_ok && rx && rx->id == k;
+  }
+
+  const auto a = run_bus_trace(7);
+  const auto b = run_bus_trace(7);
+  bool same = a.size() == b.size();
+  for (size_t i = 0; same && i < a.size(); ++i)
+    same = a[i].id == b[i].id && a[i].t_us == b[i].t_us;
+
+  // burst drain: 작은 ring에서 wrap-around 넘어가도 순서 유지
+  using SmallBus = BasicFakeCanBus<7, 8, 64>;
+  SmallBus::Config small;
+  small.rx_overflow = OverflowPolicy::DropNewest;
+  SmallBus burst(small);
+  uint32_t next_id = 0, expect_id = 0;
+  bool burst_ok = true;
+  for (int round = 0; round < 50; ++round) {
+    for (int k = 0; k < 5; ++k) { CanFrame f; f.id = next_id++; burst.push_rx(f); }
+    burst.poll(0);
+    CanFrame buf[16];
+    const size_t n = burst.drain_rx(buf);
+    burst_ok = burst_ok && n == 5;
+    for (size_t i = 0; i < n; ++i) burst_ok = burst_ok && buf[i].id == expect_id++;
+  }
+  // 용량 초과: 7개만 남고 나머지는 overflow
+  for (int k = 0; k < 10; ++k) { CanFrame f; f.id = 1000 + k; burst.push_rx(f); }
+  burst.poll(0);
+  CanFrame buf[16];
+  const size_t n_full = burst.drain_rx(buf);
+  burst_ok = burst_ok && n_full == 7 && buf[0].id == 1000 && buf[6].id == 1006 && burst.rx_overflows() == 3;
+
+  CanFrame txs[10];
+  for (uint32_t k = 0; k < 10; ++k) txs[k].id = 0x200 + k;
+  const size_t n_tx = burst.push_tx_batch(txs, 10);
+  const size_t n_tx_out = burst.drain_tx(buf);
+  burst_ok = burst_ok && n_tx == 8 && n_tx_out == 8 && buf[7].id == 0x207 && burst.tx_overflows() == 2;
+
+  os << "\n[FAKECAN: delivery order]\n";
+  os << "Same-time FIFO     : " << (fifo_ok ? "PASS" : "FAIL") << "\n";
+  os << "Same seed -> same  : " << (same ? "PASS" : "FAIL") << " (" << a.size() << " frames)\n";
+  // overflow 정책: DropOldest는 최신 7개, CountAndFlag는 DTC flag
+  StaticRing<int, 4> oldest(OverflowPolicy::DropOldest);
+  for (int v = 0; v < 10; ++v) oldest.push(v);
+  int first = -1;
+  oldest.pop(first);
+  bool policy_ok = first == 6 && oldest.size() == 3 && oldest.overflows() == 6 && !oldest.overflow_flag();
+
+  SmallBus::Config flag_cfg;
+  flag_cfg.rx_overflow = OverflowPolicy::CountAndFlag;
+  SmallBus flagged(flag_cfg);
+  for (int k = 0; k < 7; ++k) flagged.push_rx(CanFrame{});
+  flagged.poll(0);
+  policy_ok = policy_ok && !flagged.overflow_dtc();
+  flagged.push_rx(CanFrame{});
+  flagged.poll(0);
+  policy_ok = policy_ok && flagged.overflow_dtc() && flagged.rx_overflows() == 1 && flagged.rx_size() == 7;
+  flagged.clear_overflow_dtc();
+  policy_ok = policy_ok && !flagged.overflow_dtc();
+
+  os << "Burst drain/batch  : " << (burst_ok ? "PASS" : "FAIL") << "\n";
+  os << "Overflow policy    : " << (policy_ok ? "PASS" : "FAIL") << "\n";
+  const bool ok = fifo_ok && same && burst_ok && policy_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("fakecan", "bus_delivery_order", run_fakecan_bus_case);
+
+// =======================
+// FakeCanNetwork: 80% 버스 부하에서 0x200(actuator)이 10ms 주기 안에 도착하는지
+// =======================
+static bool run_can_load_case(std::ostream& os) {
+  FakeCanNetwork net(FakeCanNetwork::Config{500000, true});
+  const auto vcu  = net.attach();   // 0x100 command 송신
+  const auto ctrl = net.attach();   // 0x200 actuator 송신
+  const auto load = net.attach();   // 높은 우선순위 부하 트래픽
+  const auto tool = net.attach();   // 낮은 우선순위 부하 트래픽
+
+  constexpr uint64_t CYCLE_US = 10000;
+  constexpr uint64_t SIM_US = 2000000;     // 2s
+
+  // 8 byte 프레임(worst stuffing 135 bit = 270us) 11개를 3.85ms 주기로 + 0x100/0x200: 약 80%
+  constexpr uint32_t LOAD_IDS = 11;
+  constexpr uint64_t LOAD_PERIOD_US = 3850;
+
+  uint64_t next_load[LOAD_IDS];
+  for (uint32_t k = 0; k < LOAD_IDS; ++k) next_load[k] = k * (LOAD_PERIOD_US / LOAD_IDS);
+
+  for (uint64_t t = 0; t < SIM_US; t += 100) {
+    if (t % CYCLE_US == 0) {
+      CanFrame cmd; cmd.id = 0x100; cmd.dlc = 4;
+      net.send(vcu, cmd, t);
+      CanFrame act; act.id = 0x200; act.dlc = 2;
+      net.send(ctrl, act, t + 500);         // 제어 연산 후 송신
+    }
+    for (uint32_t k = 0; k < LOAD_IDS; ++k) {
+      if (t >= next_load[k]) {
+        CanFrame f; f.id = (k < 8) ? 0x080 + k : 0x300 + k; f.dlc = 8;
+        net.send(k < 8 ? load : tool, f, next_load[k]);
+        next_load[k] += LOAD_PERIOD_US;
+      }
+    }
+    net.run_until(t + 100);
+    while (net.receive(vcu)) {}
+    while (net.receive(ctrl)) {}
+    while (net.receive(load)) {}
+    while (net.receive(tool)) {}
+  }
+
+  const double util = net.utilization();
+  const auto& st = net.id_stats();
+  const auto it = st.find(0x200);
+  const bool act_all = (it != st.end()) && it->second.frames >= SIM_US / CYCLE_US - 1;
+  const bool act_deadline = act_all && it->second.max_latency_us <= CYCLE_US;
+  const bool load_ok = util >= 0.75 && util <= 0.90;
+
+  os << "\n[FAKECAN NETWORK: 500kbit/s load]\n";
+  os << "Bus utilization    : " << util * 100.0 << " %   (" << (load_ok ? "PASS" : "FAIL") << ")\n";
+  for (uint32_t id : {0x100u, 0x200u}) {
+    const auto s = st.find(id);
+    if (s == st.end()) continue;
+    os << "0x" << std::hex << id << std::dec
+              << " frames=" << s->second.frames
+              << " latency mean/max = " << s->second.mean_latency_us()
+              << " / " << s->second.max_latency_us << " us\n";
+  }
+  os << "0x200 within 10ms  : " << (act_deadline ? "PASS" : "FAIL") << "\n";
+  os << "RESULT: " << ((load_ok && act_deadline) ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return load_ok && act_deadline;
+}
+SCENARIO_CASE("fakecan", "bus_load_80pct", run_can_load_case);
+
+// =======================
+// CAN codec: compile-time signal layout == 기존 hand-packed codec (bit 단위)
+// =======================
+using MotorolaU16 = Signal<7, 16, false, std::ratio<1>, std::ratio<0>, ByteOrder::Motorola>;
+using MotorolaS12 = Signal<11, 12, true, std::ratio<1>, std::ratio<0>, ByteOrder::Motorola>;
+
+constexpr uint64_t motorola_get_u16() {
+  uint8_t d[8]{0x12, 0x34};
+  return MotorolaU16::get_raw(d);
+}
+constexpr int64_t motorola_roundtrip_s12(int64_t v) {
+  uint8_t d[8]{};
+  MotorolaS12::set_raw(d, static_cast<uint64_t>(v));
+  return MotorolaS12::get_int(d);
+}
+constexpr int64_t intel_straddle(uint64_t v) {   // byte 경계 걸친 signal
+  uint8_t d[8]{0xFF, 0xFF, 0xFF, 0xFF};
+  Signal<5, 13>::set_raw(d, v);
+  return static_cast<int64_t>(Signal<5, 13>::get_raw(d)) + (d[0] & 0x1F) + (d[2] >> 2);
+}
+static_assert(motorola_get_u16() == 0x1234, "motorola byte order");
+static_assert(motorola_roundtrip_s12(-1000) == -1000, "motorola signed");
+static_assert(intel_straddle(0x1ABC) == 0x1ABC + 0x1F + 0x3F, "intel straddle keeps neighbours");
+
+// 이전 hand-packed 구현 (기준)
+static CanFrame legacy_encode_cmd(const Inputs& in) {
+  CanFrame f; f.id = 0x100; f.dlc = 4;
+  int16_t vel = static_cast<int16_t>(in.target_velocity * 1000);
+  f.data[0] = vel & 0xFF;
+  f.data[1] = (vel >> 8) & 0xFF;
+  f.data[2] = (in.drive_enable ? 1 : 0) | (in.estop_button ? 2 : 0) | (in.operator_ack ? 4 : 0);
+  f.data[3] = (in.comms_ok ? 1 : 0) | (in.battery_ok ? 2 : 0);
+  return f;
+}
+static CanFrame legacy_encode_act(const Outputs& out) {
+  CanFrame f; f.id = 0x200; f.dlc = 2;
+  int16_t cmd = static_cast<int16_t>(out.motor_cmd * 1000);
+  f.data[0] = cmd & 0xFF;
+  f.data[1] = (cmd >> 8) & 0xFF;
+  return f;
+}
+
+static bool run_can_codec_case(std::ostream& os) {
+  os << "\n[CAN CODEC: signal layout vs legacy]\n";
+  std::mt19937_64 rng(12);
+  std::uniform_real_distribution<double> vel(-32.0, 32.0);
+  std::uniform_int_distribution<int> bit(0, 1);
+  std::uniform_int_distribution<int> code(0, 0xFFFF);
+
+  int mismatches = 0;
+  for (int i = 0; i < 100000; ++i) {
+    Inputs in{};
+    in.target_velocity = vel(rng);
+    in.drive_enable = bit(rng); in.estop_button = bit(rng); in.operator_ack = bit(rng);
+    in.comms_ok = bit(rng); in.battery_ok = bit(rng);
+
+    const CanFrame a = encode_cmd(in), b = legacy_encode_cmd(in);
+    if (a.id != b.id || a.dlc != b.dlc || std::memcmp(a.data, b.data, 8) != 0) ++mismatches;
+
+    // decode: 기존 식 vel / 1000.0 과 bit 동일
+    Inputs d{};
+    decode_cmd(a, d);
+    const int16_t raw = static_cast<int16_t>(b.data[0] | (b.data[1] << 8));
+    const double ref_vel = raw / 1000.0;
+    if (!same_bits(d.target_velocity, ref_vel) || d.drive_enable != in.drive_enable ||
+        d.estop_button != in.estop_button || d.operator_ack != in.operator_ack ||
+        d.comms_ok != in.comms_ok || d.battery_ok != in.battery_ok) ++mismatches;
+
+    Outputs o{};
+    o.motor_cmd = vel(rng) / 32.0;
+    const CanFrame x = encode_act(o), y = legacy_encode_act(o);
+    if (x.id != y.id || x.dlc != y.dlc || std::memcmp(x.data, y.data, 8) != 0) ++mismatches;
+
+    o.fault_code = static_cast<uint16_t>(code(rng));
+    o.drive_cmd = bit(rng); o.lift_cmd = bit(rng); o.dump_cmd = bit(rng);
+    Outputs r{};
+    decode_diag(encode_diag(o), r);
+    if (r.fault_code != o.fault_code || r.drive_cmd != o.drive_cmd ||
+        r.lift_cmd != o.lift_cmd || r.dump_cmd != o.dump_cmd) ++mismatches;
+  }
+
+  // 범위 밖 값은 saturate
+  Inputs big{}; big.target_velocity = 1e9;
+  Inputs back{};
+  decode_cmd(encode_cmd(big), back);
+  const bool sat_ok = back.target_velocity == 32.767;
+
+  // 다른 id는 무시
+  Inputs keep{}; keep.target_velocity = 0.5;
+  decode_cmd(encode_act(Outputs{}), keep);
+  const bool id_ok = keep.target_velocity == 0.5;
+
+  const bool ok = mismatches == 0 && sat_ok && id_ok;
+  os << "mismatches=" << mismatches << " saturate=" << (sat_ok ? "PASS" : "FAIL")
+            << " id_filter=" << (id_ok ? "PASS" : "FAIL") << "\n";
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("codec", "signal_layout", run_can_codec_case);
+
+// =======================
+// runtime codec(fakecan_codec.hpp) = DBC 생성 codec (gen/vehicle_dbc.hpp)
+// - 같은 타입인지 (hand layout이 다시 생기면 compile error)
+// - copy_cmd_fields: 0x100 signal field만, 나머지는 그대로
+// - 모르는 id는 false
+// (wire layout 자체는 codec/signal_layout이 기존 byte 식과 비교)
+// =======================
+static_assert(std::is_same<can_msg::Cmd, vehicle_dbc::VCU_Cmd>::value, "runtime codec must come from the DBC");
+static_assert(std::is_same<can_msg::Act, vehicle_dbc::CTRL_Act>::value, "runtime codec must come from the DBC");
+static_assert(std::is_same<can_msg::Diag, vehicle_dbc::CTRL_Diag>::value, "runtime codec must come from the DBC");
+
+static bool same_frame(const CanFrame& a, const CanFrame& b) {
+  return a.id == b.id && a.dlc == b.dlc && std::memcmp(a.data, b.data, 8) == 0;
+}
+
+static bool run_dbc_codec_case(std::ostream& os) {
+  os << "\n[DBC CODEC: runtime codec from can/vehicle.dbc]\n";
+  std::mt19937_64 rng(13);
+  std::uniform_real_distribution<double> vel(-40.0, 40.0);
+  std::uniform_int_distribution<int> bit(0, 1);
+  std::uniform_int_distribution<int> code(0, 0xFFFF);
+
+  int mismatches = 0;
+  for (int i = 0; i < 10000; ++i) {
+    Inputs in{};
+    in.target_velocity = vel(rng);
+    in.drive_enable = bit(rng); in.estop_button = bit(rng); in.operator_ack = bit(rng);
+    in.comms_ok = bit(rng); in.battery_ok = bit(rng);
+    in.lift_request = bit(rng); in.velocity = vel(rng); in.step_id = i;
+
+    // copy: 0x100 field만, 값은 양자화 없이
+    Inputs to{};
+    copy_cmd_fields(in, to);
+    const Inputs dflt{};
+    if (!same_bits(to.target_velocity, in.target_velocity) || to.drive_enable != in.drive_enable ||
+        to.estop_button != in.estop_button || to.operator_ack != in.operator_ack ||
+        to.comms_ok != in.comms_ok || to.battery_ok != in.battery_ok ||
+        to.lift_request != dflt.lift_request || !same_bits(to.velocity, dflt.velocity) ||
+        to.step_id != dflt.step_id) ++mismatches;
+
+    // decode: frame에 없는 field는 그대로
+    Inputs d = in;
+    d.target_velocity = 0.0;
+    decode_cmd(encode_cmd(in), d);
+    if (d.lift_request != in.lift_request || !same_bits(d.velocity, in.velocity) || d.step_id != in.step_id ||
+        std::abs(d.target_velocity - std::max(-32.768, std::min(32.767, in.target_velocity))) > 0.001) ++mismatches;   // 0 방향 절삭: 1 LSB
+
+    Outputs o{};
+    o.motor_cmd = vel(rng) / 40.0;
+    o.fault_code = static_cast<uint16_t>(code(rng));
+    o.drive_cmd = bit(rng); o.lift_cmd = bit(rng); o.dump_cmd = bit(rng);
+    Outputs x{};
+    if (!vehicle_dbc::decode(encode_act(o), x) || !vehicle_dbc::decode(encode_diag(o), x)) ++mismatches;
+    if (!same_frame(encode_act(x), encode_act(o)) || !same_frame(encode_diag(x), encode_diag(o))) ++mismatches;
+  }
+
+  // 모르는 id는 false
+  CanFrame unknown; unknown.id = 0x7FF;
+  Inputs dummy{};
+  const bool unknown_ok = !vehicle_dbc::decode(unknown, dummy);
+
+  const bool ok = mismatches == 0 && unknown_ok;
+  os << "mismatches=" << mismatches << " unknown_id=" << (unknown_ok ? "PASS" : "FAIL") << "\n";
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("codec", "dbc_generated", run_dbc_codec_case);
+
+// =======================
+// LatencyHistogram: percentile 상대오차 1/16 이내 (bucket 상한 반환)
+// PROFILE=1 빌드면 ControllerCore step 계측 count도 확인
+// =======================
+static bool run_latency_histogram_case(std::ostream& os) {
+  os << "\n[LATENCY HISTOGRAM]\n";
+  constexpr uint64_t N = 200000;
+  LatencyHistogram h;
+  for (uint64_t v = 1; v <= N; ++v) h.record(v);
+
+  bool ok = (h.count() == N) && (h.max() == N);
+  for (double p : {50.0, 99.0, 99.99}) {
+    const double exact = std::ceil(p / 100.0 * N);
+    const double got = static_cast<double>(h.percentile(p));
+    const bool in_range = got >= exact && got <= exact * (1.0 + 1.0 / LatencyHistogram::SUB_COUNT);
+    ok = ok && in_range;
+    os << "p" << p << ": exact=" << exact << " hist=" << got
+              << " (" << (in_range ? "PASS" : "FAIL") << ")\n";
+  }
+
+  // 작은 값(<16)은 정확히
+  LatencyHistogram small;
+  for (uint64_t v = 0; v < 16; ++v) small.record(v);
+  ok = ok && small.percentile(50.0) == 7 && small.percentile(100.0) == 15;
+
+#if defined(CONTROLLER_PROFILE)
+  ControllerCore core;
+  Inputs in{};
+  in.comms_ok = true; in.battery_ok = true; in.drive_enable = true;
+  for (int i = 0; i < 1000; ++i) core.step(in, DT_S);
+  in.estop_button = true;
+  for (int i = 0; i < 10; ++i) core.step(in, DT_S);
+
+  const StepProfiler& prof = core.profiler();
+  const bool prof_ok = prof[StepPhase::Total].count() == 1010 &&
+                       prof[StepPhase::CommsFilter].count() == 1010 &&
+                       prof[StepPhase::StateHandler].count() == 1000 &&
+                       prof[StepPhase::DebugSnapshot].count() == 1000;
+  prof.print(os, profile_ticks_per_ns());
+  os << "step profiler counts: " << (prof_ok ? "PASS" : "FAIL") << "\n";
+  ok = ok && prof_ok;
+#endif
+
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("instrumentation", "latency_histogram", run_latency_histogram_case);
+
+// =======================
+// PeriodicExecutive: VirtualClock으로 (task가 clock.advance_us로 실행시간을 흉내 -> 결과가 정확히 결정됨)
+// - light: 10ms 주기, 200us 실행 / hog: 50ms 주기 offset 5ms, budget 1ms인데 7ms 실행
+//   -> hog 매번 overrun, hog 뒤의 light(10, 60, ..., 260ms)는 2ms 늦게 시작 (jitter >=1ms bucket)
+// - late: 10ms 주기, 3번째(20ms)만 25ms 실행 -> deadline miss 1, 30/40ms release skip
+// =======================
+static bool run_periodic_executive_case(std::ostream& os) {
+  os << "\n[PERIODIC EXECUTIVE (virtual clock)]\n";
+  VirtualClock clock(1000000);
+  PeriodicExecutive exec(PeriodicExecutive::Config{}, &clock);
+  int light_runs = 0;
+  exec.add_task("light", 10000, 5000, [&] { ++light_runs; clock.advance_us(200); });
+  exec.add_task("hog", 50000, 1000, [&] { clock.advance_us(7000); }, 5000);
+  exec.run(300000);
+
+  const PeriodicTaskStats* light = exec.stats("light");
+  const PeriodicTaskStats* hog = exec.stats("hog");
+  if (!light || !hog) {
+    os << "stats missing\nRESULT: ❌ FAIL\n\n";
+    return false;
+  }
+  exec.print_report(os);
+
+  const std::size_t LAST = PeriodicTaskStats::JITTER_EDGES_NS.size();
+  const bool hog_ok = hog->runs == 6 && hog->overruns == 6 && hog->max_exec_ns == 7000000 &&
+                      hog->sum_exec_ns == 6 * 7000000ull && hog->deadline_misses == 0 &&
+                      hog->jitter_hist[0] == 6 && hog->max_jitter_ns == 0;
+  const bool light_ok = light->runs == 30 && light_runs == 30 && light->overruns == 0 &&
+                        light->deadline_misses == 0 && light->skipped_periods == 0 &&
+                        light->max_exec_ns == 200000 && light->max_jitter_ns == 2000000 &&
+                        light->jitter_hist[0] == 24 && light->jitter_hist[LAST] == 6;
+
+  VirtualClock clock2;
+  PeriodicExecutive exec2(PeriodicExecutive::Config{}, &clock2);
+  int late_runs = 0;
+  exec2.add_task("late", 10000, 0, [&] { clock2.advance_us(++late_runs == 3 ? 25000 : 100); });
+  exec2.run(100000);
+  const PeriodicTaskStats* late = exec2.stats("late");
+  // release 0, 10, 20(->45ms 종료), 50, 60, 70, 80, 90
+  const bool late_ok = late && late->runs == 8 && late->deadline_misses == 1 && late->skipped_periods == 2 &&
+                       late->overruns == 1 && late->max_exec_ns == 25000000;
+
+  os << "Overrun counted    : " << (hog_ok ? "PASS" : "FAIL") << " (hog overruns=" << hog->overruns << "/" << hog->runs << ")\n";
+  os << "Jitter / hist      : " << (light_ok ? "PASS" : "FAIL") << " (light runs=" << light->runs
+     << " max jitter=" << light->max_jitter_ns / 1000 << " us)\n";
+  os << "Deadline miss/skip : " << (late_ok ? "PASS" : "FAIL") << " (misses=" << (late ? late->deadline_misses : 0)
+     << " skipped=" << (late ? late->skipped_periods : 0) << ")\n";
+  const bool ok = hog_ok && light_ok && late_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("instrumentation", "periodic_executive", run_periodic_executive_case);
+
+// =======================
+// CanIoThread: I/O thread <-> control thread SPSC 왕복
+// (0x100 -> InputFrame, OutputFrame -> 0x200/0x300)
+// =======================
+static bool run_can_io_thread_case(std::ostream& os) {
+  os << "\n[CAN I/O THREAD]\n";
+
+  // SpscInputSource: 쌓인 것 중 최신만, 없으면 false
+  SpscInputSource<8>::Ring ring;
+  SpscInputSource<8> src(ring);
+  InputFrame f;
+  bool src_ok = !src.read(f);
+  for (int k = 1; k <= 3; ++k) { PackedInputFrame x; x.t_us = k; ring.try_push(x); }
+  src_ok = src_ok && src.read(f) && f.t_us == 3 && src.received() == 3 && !src.read(f);
+
+  SpscOutputSink<4>::Ring out_ring;
+  SpscOutputSink<4> sink(out_ring);
+  for (int k = 0; k < 6; ++k) sink.write(OutputFrame{});
+  src_ok = src_ok && sink.dropped() == 2;
+
+  // 실제 스레드: 매 주기 hook이 0x100을 넣고, control 쪽이 쓴 출력이 0x200으로 나오는지
+  SteadyClock clock;
+  FakeCanBus bus;
+  FakeCanPort<FakeCanBus> port(bus);
+  CanIoThread<> io(port, clock, {500});
+
+  Inputs vcu{};
+  vcu.drive_enable = true;
+  vcu.target_velocity = 0.75;
+  std::atomic<int> act_seen{0};
+  std::atomic<int> diag_seen{0};
+  std::atomic<int> last_motor_milli{0};
+  io.set_sim_hook([&](uint64_t now_us) {
+    CanFrame c = encode_cmd(vcu);
+    c.t_us = now_us;
+    bus.push_rx(c);
+    CanFrame noise;   // 0x100 외 프레임은 무시
+    noise.id = 0x555;
+    bus.push_rx(noise);
+    CanFrame tx_buf[16];
+    while (size_t n = bus.drain_tx(tx_buf)) {
+      for (size_t i = 0; i < n; ++i) {
+        if (can_msg::Act::match(tx_buf[i])) {
+          Outputs o{};
+          decode_act(tx_buf[i], o);
+          last_motor_milli.store(static_cast<int>(std::lround(o.motor_cmd * 1000)));
+          act_seen.fetch_add(1);
+        } else if (can_msg::Diag::match(tx_buf[i])) {
+          diag_seen.fetch_add(1);
+        }
+      }
+    }
+  });
+  io.start();
+
+  bool rx_ok = false;
+  const uint64_t deadline = clock.now_us() + 2000000;
+  while (!rx_ok && clock.now_us() < deadline) {
+    InputFrame in;
+    rx_ok = io.input().read(in) && in.in.drive_enable && in.in.target_velocity == 0.75 && in.t_us > 0;
+    clock.sleep_until_us(clock.now_us() + 1000);
+  }
+
+  Outputs o{};
+  o.motor_cmd = 0.321;
+  o.fault_code = 7;
+  io.output().write(OutputFrame{o, clock.now_us()});
+  io.output().write(OutputFrame{o, clock.now_us()});
+  while (act_seen.load() < 2 && clock.now_us() < deadline) clock.sleep_until_us(clock.now_us() + 1000);
+  io.stop();
+
+  const auto st = io.stats();
+  const bool tx_ok = act_seen.load() == 2 && diag_seen.load() == 1 && last_motor_milli.load() == 321 &&
+                     st.tx_frames == 3 && st.tx_port_drops == 0;
+  const bool stat_ok = st.cycles > 0 && st.rx_frames > st.rx_cmd && st.rx_cmd > 0;
+
+  os << "SPSC source/sink   : " << (src_ok ? "PASS" : "FAIL") << "\n";
+  os << "RX 0x100 -> frame  : " << (rx_ok ? "PASS" : "FAIL") << "\n";
+  os << "TX frame -> 0x200  : " << (tx_ok ? "PASS" : "FAIL")
+            << " (act=" << act_seen.load() << " diag=" << diag_seen.load() << ")\n";
+  os << "I/O stats          : " << (stat_ok ? "PASS" : "FAIL")
+            << " (cycles=" << st.cycles << " rx=" << st.rx_frames << " cmd=" << st.rx_cmd << ")\n";
+  // SocketCAN: 없는 interface -> 예외 없이 닫힌 port, read/write는 no-op
+  SocketCanPort bad("ctl_no_such_if");
+  SocketCanInputSource can_src(bad);
+  SocketCanOutputSink can_sink(bad);
+  InputFrame cf;
+  can_sink.write(OutputFrame{});
+  const bool sock_ok = !bad.is_open() && !bad.error().empty() && !can_src.read(cf) && can_sink.dropped() == 1;
+  os << "SocketCAN open fail: " << (sock_ok ? "PASS" : "FAIL") << " (" << bad.error() << ")\n";
+
+  const bool ok = src_ok && rx_ok && tx_ok && stat_ok && sock_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "can_io_thread", run_can_io_thread_case);
+
+// =======================
+// SocketCAN (vcan0 있을 때만): recvmmsg/sendmmsg batch, CAN_RAW_FILTER, t_us 시간축
+//   sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+// =======================
+static bool run_socketcan_vcan_case(std::ostream& os) {
+  os << "\n[SOCKETCAN vcan0]\n";
+  if (::if_nametoindex("vcan0") == 0) return scenario_skip(os, "no vcan0");
+
+  SocketCanPort rx("vcan0");                 // 기본 필터: 0x100만
+  SocketCanPort::Config all;
+  all.filter_count = 0;
+  SocketCanPort tx("vcan0", all);
+  if (!rx.is_open() || !tx.is_open()) {
+    os << "open: " << rx.error() << tx.error() << "\nRESULT: ❌ FAIL\n\n";
+    return false;
+  }
+
+  // BATCH(32)보다 많이 -> sendmmsg/recvmmsg 여러 번, 0x100 사이사이 필터 밖 0x555
+  constexpr int N = 40;
+  std::vector<CanFrame> frames;
+  for (int k = 0; k < N; ++k) {
+    Inputs in{};
+    in.drive_enable = true;
+    in.target_velocity = 0.01 * k;
+    frames.push_back(encode_cmd(in));
+    CanFrame noise;
+    noise.id = 0x555;
+    noise.dlc = 1;
+    noise.data[0] = static_cast<uint8_t>(k);
+    frames.push_back(noise);
+  }
+  SteadyClock clock;
+  const uint64_t t0 = clock.now_us();
+  const size_t sent = tx.send(frames.data(), frames.size(), t0);
+
+  std::vector<CanFrame> got;
+  CanFrame buf[SocketCanPort::BATCH];
+  while (got.size() < N && rx.wait_readable(200000)) {
+    const size_t n = rx.receive(buf, SocketCanPort::BATCH, 0);
+    got.insert(got.end(), buf, buf + n);
+  }
+  const uint64_t t1 = clock.now_us();
+
+  bool filt_ok = got.size() == static_cast<size_t>(N);
+  bool data_ok = filt_ok, ts_ok = filt_ok;
+  for (size_t i = 0; i < got.size() && filt_ok; ++i) {
+    const CanFrame& want = frames[2 * i];
+    filt_ok = got[i].id == 0x100;
+    data_ok = data_ok && got[i].dlc == want.dlc && std::memcmp(got[i].data, want.data, 8) == 0;
+    // SteadyClock과 같은 시간축 (REALTIME epoch이면 ~50년 차이), 변환 오차 여유 1ms
+    ts_ok = ts_ok && got[i].t_us + 1000 >= t0 && got[i].t_us <= t1 + 1000 &&
+            (i == 0 || got[i].t_us >= got[i - 1].t_us);
+  }
+
+  os << "sendmmsg x" << sent << ", recv " << got.size() << " (0x100 only)\n";
+  os << "Send batch         : " << (sent == frames.size() ? "PASS" : "FAIL") << "\n";
+  os << "Kernel filter      : " << (filt_ok ? "PASS" : "FAIL") << "\n";
+  os << "Payload            : " << (data_ok ? "PASS" : "FAIL") << "\n";
+  os << "t_us monotonic     : " << (ts_ok ? "PASS" : "FAIL") << "\n";
+  const bool ok = sent == frames.size() && filt_ok && data_ok && ts_ok &&
+                  rx.rx_errors() == 0 && tx.tx_errors() == 0;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "socketcan_vcan", run_socketcan_vcan_case);
+
+// =======================
+// MuxInputSource: teleop(고 priority)가 autonomy를 덮고, 끊기면 fallback / 둘 다 끊기면 comms_ok=false
+// =======================
+struct ScriptedSource final : IInputSource {
+  bool has_new = false;
+  InputFrame next{};
+  bool read(InputFrame& f) override {
+    if (!has_new) return false;
+    f = next;
+    has_new = false;
+    return true;
+  }
+  void send(double target) { next.in.target_velocity = target; next.in.comms_ok = true; has_new = true; }
+};
+
+static bool run_mux_input_case(std::ostream& os) {
+  os << "\n[MUX INPUT SOURCE]\n";
+  VirtualClock clock;
+  ScriptedSource autonomy, teleop;
+  MuxInputSource<2> mux(clock);
+  bool ok = mux.add(autonomy, 0, 50000) && mux.add(teleop, 10, 30000);
+  ScriptedSource extra;
+  ok = ok && !mux.add(extra, 5, 0);   // 고정 용량 초과
+
+  InputFrame f;
+  ok = ok && !mux.read(f) && mux.active() == MuxInputSource<2>::NONE;   // 아직 아무것도 안 옴
+
+  // autonomy만
+  autonomy.send(0.5);
+  const bool auto_ok = mux.read(f) && mux.active() == 0 && f.in.target_velocity == 0.5 && f.in.comms_ok;
+
+  // teleop이 들어오면 덮어씀 (autonomy가 계속 보내도)
+  clock.advance_us(10000);
+  autonomy.send(0.6);
+  teleop.send(0.2);
+  bool override_ok = mux.read(f) && mux.active() == 1 && f.in.target_velocity == 0.2;
+  clock.advance_us(20000);
+  autonomy.send(0.7);
+  override_ok = override_ok && mux.read(f) && mux.active() == 1 && f.in.target_velocity == 0.2;
+
+  // teleop 30ms 초과 -> autonomy로 fallback (comms 유지)
+  clock.advance_us(15000);
+  autonomy.send(0.8);
+  const bool fallback_ok = mux.read(f) && mux.active() == 0 && f.in.target_velocity == 0.8 &&
+                           f.in.comms_ok && !mux.fresh(1) && mux.switches() == 2;
+
+  // 둘 다 stale -> 마지막 프레임 + comms_ok=false
+  clock.advance_us(60000);
+  const bool stale_ok = mux.read(f) && mux.active() == MuxInputSource<2>::NONE &&
+                        !f.in.comms_ok && !f.valid && f.in.target_velocity == 0.8;
+
+  // teleop 복귀
+  teleop.send(0.1);
+  const bool resume_ok = mux.read(f) && mux.active() == 1 && f.in.comms_ok && f.valid;
+
+  os << "Capacity/empty     : " << (ok ? "PASS" : "FAIL") << "\n";
+  os << "Single source      : " << (auto_ok ? "PASS" : "FAIL") << "\n";
+  os << "Priority override  : " << (override_ok ? "PASS" : "FAIL") << "\n";
+  os << "Stale fallback     : " << (fallback_ok ? "PASS" : "FAIL") << "\n";
+  os << "All stale -> comms : " << (stale_ok ? "PASS" : "FAIL") << "\n";
+  os << "Resume             : " << (resume_ok ? "PASS" : "FAIL") << "\n";
+  ok = ok && auto_ok && override_ok && fallback_ok && stale_ok && resume_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "mux_input_source", run_mux_input_case);
+
+// =======================
+// LogSink: 평상시 1Hz, fault latch(및 latch 중 code 변경) 전후 2s는 전 tick
+// =======================
+static bool run_log_sink_case(std::ostream& os) {
+  os << "\n[LOG SINK: decimation + fault trigger]\n";
+  LogTrigger<256> trig;
+  int n_decim = 0, n_pre = 0, n_trig = 0, n_post = 0;
+  uint64_t last_t = 0, min_pre = ~0ull;
+  bool order_ok = true;
+  for (uint64_t k = 0; k < 2000; ++k) {   // 20s @ 100Hz
+    LogRecord r;
+    r.t_us = k * 10000;
+    r.dbg.set(LogDebug::FaultLatched, k >= 1000);
+    r.dbg.fault_code = k >= 1500 ? 6 : (k >= 1000 ? 5 : 0);
+    trig.feed(r, [&](const LogRecord& rec, LogEmit kind) {
+      switch (kind) {
+        case LogEmit::Decimated: ++n_decim; break;
+        case LogEmit::PreTrigger: ++n_pre; if (rec.t_us < min_pre) min_pre = rec.t_us; break;
+        case LogEmit::Trigger: ++n_trig; break;
+        case LogEmit::PostTrigger: ++n_post; break;
+      }
+      if (kind != LogEmit::PreTrigger) {   // pre 블록은 trigger 직전에 몰아서
+        order_ok = order_ok && (rec.t_us >= last_t);
+        last_t = rec.t_us;
+      }
+    });
+  }
+  // decimated: 0..9s(10) + 12.01,13.01,14.01 + 17.01,18.01,19.01
+  // pre: 각 trigger 앞 2s 중 아직 안 찍힌 것 (2s x 100 - 간축 2줄) x 2
+  const bool trig_ok = n_trig == 2 && n_decim == 16 && n_pre == 2 * 198 && n_post == 2 * 200 &&
+                       min_pre == 8010000 && trig.triggers() == 2 && order_ok;
+  os << "decim=" << n_decim << " pre=" << n_pre << " trig=" << n_trig << " post=" << n_post << "\n";
+  os << "Trigger window     : " << (trig_ok ? "PASS" : "FAIL") << "\n";
+
+  // LogSink: control thread는 복사만, 포맷은 writer thread
+  std::ostringstream log_text;
+  ControllerCore core;
+  Inputs in{};
+  in.comms_ok = true; in.battery_ok = true; in.drive_enable = true;
+  LogSink::Trigger::Config cfg;
+  cfg.decimate_period_us = 0;   // 전부
+  LogSink sink(core, in, log_text, cfg);
+  uint32_t hb = 0;
+  sink.set_heartbeat(&hb);
+  for (uint64_t k = 0; k < 50; ++k) {
+    const Outputs out = core.step(in, DT_S);
+    if (k % 10 == 0) ++hb;
+    sink.write(OutputFrame{out, k * 10000});
+  }
+  sink.stop();
+  const bool sink_ok = sink.emitted() == 50 && sink.dropped() == 0 &&
+                       log_text.str().find("state=DRIVE") != std::string::npos &&
+                       log_text.str().find(" hb=5\n") != std::string::npos;
+  os << "Async sink         : " << (sink_ok ? "PASS" : "FAIL") << " (lines=" << sink.emitted() << ")\n";
+
+  const bool ok = trig_ok && sink_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "log_sink", run_log_sink_case);
+
+// =======================
+// Packed Inputs/Outputs: flag bit <-> bool, Inputs/Outputs와 bit 단위 왕복
+// =======================
+static bool same_inputs(const Inputs& a, const Inputs& b) {
+  for (auto f : IN_FLAG_FIELDS)
+    if (a.*f != b.*f) return false;
+  return same_bits(a.velocity, b.velocity) && same_bits(a.target_velocity, b.target_velocity) &&
+         a.scenario_id == b.scenario_id && a.step_id == b.step_id;
+}
+
+static bool run_packed_io_case(std::ostream& os) {
+  os << "\n[PACKED IO]\n";
+  std::mt19937 rng(25);
+  std::uniform_real_distribution<double> uv(-3.0, 3.0);
+  std::bernoulli_distribution coin(0.5);
+
+  // 기본값끼리 같음 (PackedInputs{} == pack(Inputs{}))
+  bool rt_ok = same_inputs(PackedInputs{}.unpack(), Inputs{}) &&
+               PackedInputs{}.flags == PackedInputs::pack(Inputs{}).flags;
+  bool acc_ok = true;
+  const double specials[] = {-0.0, 1e-300, -1e300, NAN};
+  for (int k = 0; k < 1000 && rt_ok && acc_ok; ++k) {
+    Inputs in;
+    for (auto f : IN_FLAG_FIELDS) in.*f = coin(rng);
+    in.velocity = k < 4 ? specials[k] : uv(rng);
+    in.target_velocity = uv(rng);
+    in.scenario_id = static_cast<int>(rng());
+    in.step_id = -k;
+    const PackedInputs p = PackedInputs::pack(in);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(InFlag::Count); ++i)
+      acc_ok = acc_ok && p.get(static_cast<InFlag>(i)) == in.*IN_FLAG_FIELDS[i];
+#if defined(CONTROLLER_FIXED_VELOCITY)
+    in.velocity = velocity_from_fixed(velocity_to_fixed(in.velocity));
+    in.target_velocity = velocity_from_fixed(velocity_to_fixed(in.target_velocity));
+#endif
+    rt_ok = rt_ok && same_inputs(p.unpack(), in);
+
+    Outputs out;
+    out.drive_cmd = coin(rng); out.lift_cmd = coin(rng); out.dump_cmd = coin(rng);
+    out.motor_cmd = uv(rng);
+    out.fault_code = static_cast<std::uint16_t>(rng());
+    const PackedOutputs po = PackedOutputs::pack(out);
+    acc_ok = acc_ok && po.get(OutFlag::DriveCmd) == out.drive_cmd && po.get(OutFlag::LiftCmd) == out.lift_cmd &&
+             po.get(OutFlag::DumpCmd) == out.dump_cmd;
+    rt_ok = rt_ok && same_output(po.unpack(), out);
+  }
+
+  PackedInputs p;
+  p.set(InFlag::EstopButton, true);
+  p.set(InFlag::BatteryOk, false);
+  const Inputs u = p.unpack();
+  acc_ok = acc_ok && u.estop_button && !u.battery_ok && u.comms_ok && !u.drive_enable;
+
+  // 고정소수점: 1e-6 격자, 격자 위 값은 그대로 왕복, 범위 밖/NaN은 clamp
+  bool fixed_ok = velocity_to_fixed(0.3) == 300000 && velocity_to_fixed(-1.0000004) == -1000000 &&
+                  velocity_to_fixed(1e12) == 2147483647 && velocity_to_fixed(NAN) == -2147483647;
+  for (std::int32_t q = -2000000000; q <= 2000000000 && fixed_ok; q += 99999989)
+    fixed_ok = velocity_to_fixed(velocity_from_fixed(q)) == q;
+
+  const bool size_ok = sizeof(PackedInputFrame) < sizeof(InputFrame) && sizeof(PackedInputFrame) <= 64 &&
+                       sizeof(PackedOutputFrame) < sizeof(OutputFrame) && sizeof(LogRecord) <= 64;
+  os << "sizeof Inputs=" << sizeof(Inputs) << " PackedInputs=" << sizeof(PackedInputs)
+     << " InputFrame=" << sizeof(InputFrame) << "->" << sizeof(PackedInputFrame)
+     << " LogRecord=" << sizeof(LogRecord) << "\n";
+  os << "Round trip         : " << (rt_ok ? "PASS" : "FAIL") << "\n";
+  os << "Flag accessors     : " << (acc_ok ? "PASS" : "FAIL") << "\n";
+  os << "Fixed velocity     : " << (fixed_ok ? "PASS" : "FAIL") << "\n";
+  os << "Cache line         : " << (size_ok ? "PASS" : "FAIL") << "\n";
+  const bool ok = rt_ok && acc_ok && fixed_ok && size_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "packed_io", run_packed_io_case);
+
+// =======================
+// TelemetryLogger: 쓰고(writer thread) TelemetryReader로 다시 읽으면 필드 전부 같음
+// ring이 가득 차면 log()가 false + dropped(), 파일엔 받아들인 것만 순서대로
+// =======================
+static bool same_telemetry(const TelemetryRecord& a, const TelemetryRecord& b) {
+  return a.tick == b.tick && a.flags == b.flags && a.state == b.state &&
+         a.fault_reason == b.fault_reason && a.fault_code == b.fault_code &&
+         same_bits(a.target_vel, b.target_vel) && same_bits(a.vel, b.vel) &&
+         same_bits(a.motor_cmd, b.motor_cmd) && same_bits(a.integ, b.integ) &&
+         same_bits(a.u_unsat, b.u_unsat) && same_bits(a.u_sat, b.u_sat) &&
+         same_bits(a.lift_p, b.lift_p) && same_bits(a.dump_p, b.dump_p);
+}
+
+static std::vector<TelemetryRecord> read_telemetry(TelemetryReader& rd) {
+  std::vector<TelemetryRecord> v;
+  rd.for_each([&](const TelemetryRecord& r) { v.push_back(r); });
+  return v;
+}
+
+static bool run_telemetry_logger_case(std::ostream& os) {
+  os << "\n[TELEMETRY LOGGER]\n";
+  const std::string path = "/tmp/controller_tests_" + std::to_string(::getpid()) + ".tlm";
+
+  // 1) fault_estop 한 바퀴 (state/fault/flag가 다 바뀌는 구간)
+  FaultEstop sc;
+  ControllerCore core;
+  Plant plant;
+  Inputs in{};
+  sc.init(in);
+  std::vector<TelemetryRecord> sent;
+  bool log_ok = true;
+  {
+    TelemetryLogger tlm(path, DT_S);
+    for (int tick = 0; tick < sc.end_tick(); ++tick) {
+      sc.apply(tick, in);
+      const Outputs out = core.step(in, DT_S);
+      plant.step(out, in, DT_S);
+      sent.push_back(make_telemetry_record(tick, in, out, core.debug(), plant.lift_pos, plant.dump_pos));
+      log_ok = log_ok && tlm.log(sent.back());
+    }
+    log_ok = log_ok && tlm.enabled() && tlm.dropped() == 0;
+  }   // 소멸자: 남은 레코드 다 쓰고 닫음
+
+  TelemetryReader rd(path);
+  const std::vector<TelemetryRecord> got = read_telemetry(rd);
+  bool rt_ok = log_ok && rd.is_open() && rd.dt_s() == DT_S && rd.record_count() == sent.size() &&
+               got.size() == sent.size();
+  for (std::size_t i = 0; rt_ok && i < sent.size(); ++i) rt_ok = same_telemetry(sent[i], got[i]);
+
+  // 2) ring 가득: writer보다 빨리 밀어넣어서 drop이 날 때까지
+  std::vector<TelemetryRecord> accepted;
+  std::uint64_t rejected = 0, dropped = 0, written = 0;
+  {
+    TelemetryLogger tlm(path, DT_S);
+    TelemetryRecord r = sent.back();
+    for (int k = 0; k < 1000000 && rejected < 100; ++k) {
+      r.tick = k;
+      r.vel = k * 0.5;
+      if (tlm.log(r)) accepted.push_back(r);
+      else ++rejected;
+    }
+    dropped = tlm.dropped();
+    written = tlm.written();
+  }
+  // BATCH_SIZE 여러 번 넘는 파일: for_each 두 번 (매번 처음부터) 같은 결과
+  TelemetryReader full(path);
+  const std::vector<TelemetryRecord> all = read_telemetry(full);
+  bool drop_ok = rejected == 100 && dropped == rejected && written <= accepted.size() &&
+                 full.is_open() && all.size() == accepted.size() && accepted.size() > 2 * TelemetryReader::BATCH_SIZE &&
+                 read_telemetry(full).size() == all.size();
+  for (std::size_t i = 0; drop_ok && i < accepted.size(); ++i) drop_ok = same_telemetry(accepted[i], all[i]);
+  std::remove(path.c_str());
+
+  TelemetryReader bad("/dev/null");
+  const bool reject_ok = !bad.is_open() && !bad.error().empty() && read_telemetry(bad).empty();
+
+  os << "Round trip         : " << (rt_ok ? "PASS" : "FAIL") << " (records=" << got.size() << ")\n";
+  os << "Ring full -> drop  : " << (drop_ok ? "PASS" : "FAIL") << " (accepted=" << accepted.size()
+     << " dropped=" << dropped << ")\n";
+  os << "Reject non-tlm     : " << (reject_ok ? "PASS" : "FAIL") << "\n";
+  const bool ok = rt_ok && drop_ok && reject_ok;
+  os << "RESULT: " << (ok ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return ok;
+}
+SCENARIO_CASE("io", "telemetry_logger", run_telemetry_logger_case);
 
 // =======================
-// main
+// Columnar trace: 쓰고(mmap) 다시 읽은 column으로 계산한 metrics == 실행 중 누적 metrics (bit 동일)
 // =======================
-int main() {
-  // ---- Drive suite ----
+static bool run_columnar_trace_case(std::ostream& os) {
+  os << "\n[COLUMNAR TRACE]\n";
+  const std::string path = "/tmp/controller_tests_" + std::to_string(::getpid()) + ".ctr";
+  DriveStep_0_1 sc;
+  const double step_time = sc.step_tick() * DT_S, end_time = sc.end_tick() * DT_S;
+
+  ControllerCore core;
+  Plant plant;
+  Inputs in{};
+  sc.init(in);
+  StepMetricsAccumulator live(step_time, end_time, sc.v0(), sc.v1());
   {
-    ControllerCore core; core.reset();
-    Plant plant;
+    ColumnarTraceWriter w(path, sc.end_tick() - 10, DT_S);   // 일부러 모자라게 -> 마지막 10개 drop
+    for (int tick = 0; tick < sc.end_tick(); ++tick) {
+      sc.apply(tick, in);
+      const Outputs out = core.step(in, DT_S);
+      plant.step(out, in, DT_S);
+      if (tick < sc.end_tick() - 10) live.add(Sample{tick * DT_S, in.target_velocity, in.velocity, out.motor_cmd});
+      w.append(make_telemetry_record(tick, in, out, core.debug(), plant.lift_pos, plant.dump_pos));
+    }
+    if (w.rows() != static_cast<uint64_t>(sc.end_tick() - 10) || w.dropped() != 10) {
+      os << "writer rows/dropped mismatch\nRESULT: ❌ FAIL\n\n";
+      return false;
+    }
+  }
 
-    DriveStep_0_1  s1;
-    DriveStep_1_03 s2;
-    DriveStep_03_08 s3;
+  ColumnarTraceReader r(path);
+  bool ok = r.is_open() && r.rows() == static_cast<uint64_t>(sc.end_tick() - 10) && r.dt_s() == DT_S;
+  const double* t = r.column<double>(TC_TIME_S);
+  const double* target = r.column<double>("target_vel");
+  const double* vel = r.column<double>(TC_VEL);
+  const double* u = r.column<double>(TC_MOTOR_CMD);
+  const std::int32_t* tick_col = r.column<std::int32_t>(TC_TICK);
+  ok = ok && t && target && vel && u && tick_col && tick_col[42] == 42 && !r.column<std::int32_t>("vel");
 
-    std::vector<StepResult> results;
-    results.reserve(3);
+  bool same = false;
+  if (ok) {
+    const Metrics a = live.result();
+    const Metrics b = compute_metrics_step(t, target, vel, u, r.rows(), step_time, end_time, sc.v0(), sc.v1());
+    same = same_bits(a.rise_time, b.rise_time) && same_bits(a.overshoot_pct, b.overshoot_pct) &&
+           same_bits(a.settling_time, b.settling_time) && same_bits(a.ss_error, b.ss_error) &&
+           same_bits(a.max_sat_duration, b.max_sat_duration);
+  }
+  ColumnarTraceReader bad("/dev/null");
+  bool reject_ok = !bad.is_open() && !bad.error().empty();
 
-    auto r1 = run_drive_case(s1, core, plant);
-    print_step_report(r1);
-    results.push_back(r1);
+  // header 손상: column<T>()가 mapping 밖을 읽게 되는 desc는 open에서 거절
+  std::vector<char> bytes;
+  if (std::FILE* f = std::fopen(path.c_str(), "rb")) {
+    char buf[65536];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+    std::fclose(f);
+  }
+  const std::string bad_path = path + ".bad";
+  auto rejects = [&](auto corrupt) {
+    std::vector<char> b = bytes;
+    TraceFileHeader h;
+    std::memcpy(&h, b.data(), sizeof(h));
+    TraceColumnDesc* d = reinterpret_cast<TraceColumnDesc*>(b.data() + sizeof(TraceFileHeader));
+    corrupt(h, d[TC_VEL]);
+    std::memcpy(b.data(), &h, sizeof(h));
+    std::FILE* f = std::fopen(bad_path.c_str(), "wb");
+    if (!f) return false;
+    std::fwrite(b.data(), 1, b.size(), f);
+    std::fclose(f);
+    ColumnarTraceReader cr(bad_path);
+    return !cr.is_open() && !cr.error().empty();
+  };
+  const bool corrupt_ok = bytes.size() > sizeof(TraceFileHeader) &&
+      rejects([](TraceFileHeader&, TraceColumnDesc& d) { d.elem_size = 1; }) &&
+      rejects([](TraceFileHeader&, TraceColumnDesc& d) { d.type = 9; }) &&
+      rejects([](TraceFileHeader&, TraceColumnDesc& d) { d.offset += 4; }) &&
+      rejects([](TraceFileHeader&, TraceColumnDesc& d) { d.offset = ~0ull - 7; }) &&
+      rejects([](TraceFileHeader& h, TraceColumnDesc&) { h.capacity = h.rows = 1ull << 61; }) &&
+      rejects([](TraceFileHeader& h, TraceColumnDesc&) { h.column_count = 0xffffffffu; });
+  reject_ok = reject_ok && corrupt_ok;
+  std::remove(bad_path.c_str());
+  std::remove(path.c_str());
+
+  os << "Columns/rows       : " << (ok ? "PASS" : "FAIL") << " (rows=" << r.rows() << ")\n";
+  os << "Metrics == live    : " << (same ? "PASS" : "FAIL") << "\n";
+  os << "Reject bad files   : " << (reject_ok ? "PASS" : "FAIL") << "\n";
+  const bool all = ok && same && reject_ok;
+  os << "RESULT: " << (all ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return all;
+}
+SCENARIO_CASE("trace", "columnar_roundtrip", run_columnar_trace_case);
+
+// =======================
+// CAN capture -> replay: fakecan_demo와 같은 루프를 기록하고, 기록한 RX만으로 다시 돌린
+// 0x200 == 기록 (bit 단위), 기록의 0x200 1바이트를 바꾸면 정확히 그 tick에서 잡힘
+// =======================
+static bool run_can_replay_case(std::ostream& os) {
+  os << "\n[CAN CAPTURE / REPLAY]\n";
+  const std::string path = "/tmp/controller_tests_" + std::to_string(::getpid()) + ".cap";
+  constexpr int TICKS = 3000;   // 30s
+
+  FakeCanBus::Config bus_cfg;
+  bus_cfg.delay_us = 2000;
+  bus_cfg.jitter_us = 3000;
+  bus_cfg.drop_rate = 0.02;
+  FakeCanBus bus(bus_cfg);
+  VirtualClock clock;
+  CommsWatchdog comms(clock);
+  ControllerCore core;
+  Plant plant;
+
+  Inputs vcu{};              // 상대 node(VCU)가 보내는 명령
+  vcu.drive_enable = true;
+  vcu.target_velocity = 1.0;
+  Inputs in = vcu;           // controller 쪽은 CAN으로만 갱신
+  const CanFrame boot = encode_cmd(in);
+
+  std::uint64_t recorded = 0, dropped = 0;
+  {
+    CanCaptureWriter cap(path, &boot, CanCaptureWriter::Config{true});
+    bus.set_tap(&cap);
+    CanFrame rx_buf[64], tx_buf[8];
+    for (int tick = 0; tick < TICKS; ++tick) {
+      if (tick == 500) vcu.target_velocity = 0.4;
+      vcu.estop_button = tick >= 1200 && tick < 1250;
+      vcu.operator_ack = tick >= 1400 && tick < 1405;
 
-    core.reset(); plant = Plant{};
-    auto r2 = run_drive_case(s2, core, plant);
-    print_step_report(r2);
-    results.push_back(r2);
+      bus.poll(clock);
+      const size_t n_rx = bus.drain_rx(rx_buf);
+      for (size_t i = 0; i < n_rx; ++i) decode_cmd(rx_buf[i], in);
+      if (n_rx) comms.kick();
+      in.comms_ok = comms.ok();
+      if (tick < 2000 || tick >= 2030) bus.push_rx(encode_cmd(vcu));   // 300ms 침묵 -> comms timeout
 
-    core.reset(); plant = Plant{};
-    auto r3 = run_drive_case(s3, core, plant);
-    print_step_report(r3);
-    results.push_back(r3);
+      const Outputs out = core.step(in, DT_S);
+      plant.step(out, in, DT_S);
+      bus.push_tx(encode_act(out));
+      while (bus.drain_tx(tx_buf)) {}
+      clock.advance_us(10000);
+    }
+    bus.set_tap(nullptr);
+    cap.stop();
+    recorded = cap.records();
+    dropped = cap.dropped();
+  }
+
+  CanCaptureReader r(path);
+  std::remove(path.c_str());
+  bool read_ok = r.is_open() && r.has_boot_cmd() && r.records().size() == recorded && dropped == 0;
 
-    print_suite_summary(results);
+  CanReplayResult same;
+  if (read_ok) {
+    CanReplayInputSource src(r);
+    ControllerCore core2;
+    Plant plant2;
+    same = replay_can_capture(src, core2, plant2);
   }
+  const bool replay_ok = same.ok() && same.ticks == TICKS;
 
-  // ---- Fault tests ----
-  bool ok_estop = run_fault_estop_case();
-  bool ok_comms = run_comms_lost_case();
+  // 1500번째 tick의 0x200을 1바이트 바꿔서 다시
+  bool detect_ok = false;
+  if (read_ok) {
+    std::vector<CanCaptureRecord> recs = r.records();
+    int tx_seen = 0;
+    for (auto& rec : recs) {
+      if (rec.dir == static_cast<std::uint8_t>(CanDir::Tx) && rec.id == can_msg::Act::id && tx_seen++ == 1500) {
+        rec.data[0] ^= 0x01;
+        break;
+      }
+    }
+    CanReplayInputSource src(recs.data(), recs.size(), &boot);
+    ControllerCore core3;
+    Plant plant3;
+    const CanReplayResult bad = replay_can_capture(src, core3, plant3);
+    detect_ok = bad.mismatches == 1 && bad.first_mismatch_tick == 1500;
+  }
 
-  return (ok_estop && ok_comms) ? 0 : 1;
+  os << "Capture/read       : " << (read_ok ? "PASS" : "FAIL") << " (frames=" << recorded << ", dropped=" << dropped << ")\n";
+  os << "Replay 0x200 exact : " << (replay_ok ? "PASS" : "FAIL") << " (ticks=" << same.ticks
+     << ", mismatches=" << same.mismatches << ")\n";
+  os << "Detect altered tick: " << (detect_ok ? "PASS" : "FAIL") << "\n";
+  const bool all = read_ok && replay_ok && detect_ok;
+  os << "RESULT: " << (all ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return all;
 }
+SCENARIO_CASE("replay", "can_capture", run_can_replay_case);
+
+// =======================
+// VehiclePlant: legacy 파라미터 == Plant (bit), RK4 정확도, 정지 마찰/경사, lift 유압
+// =======================
+static bool run_vehicle_plant_case(std::ostream& os) {
+  os << "\n[VEHICLE PLANT]\n";
+
+  // 1) legacy(): 랜덤 명령에서 Plant와 bit 동일
+  bool legacy_ok = true;
+  {
+    Plant a;
+    VehiclePlant b(VehiclePlantParams::legacy());
+    Inputs ia{}, ib{};
+    std::mt19937_64 rng(23);
+    std::uniform_real_distribution<double> cmd(-1.0, 1.0);
+    for (int tick = 0; tick < 5000 && legacy_ok; ++tick) {
+      Outputs out{};
+      out.motor_cmd = (tick % 97 < 10) ? 0.0 : cmd(rng);
+      out.lift_cmd = (tick / 300) % 2 == 1;
+      a.step(out, ia, DT_S);
+      b.step(out, ib, DT_S);
+      legacy_ok = same_bits(a.vel, b.vel) && same_bits(ia.velocity, ib.velocity) &&
+                  b.lift_pos == 0.0 && !ib.lift_complete;
+    }
+  }
+
+  // 2) 1차 system 해석해 대비: RK4 << Euler
+  auto first_order_err = [](PlantIntegrator integ) {
+    VehiclePlantParams p = VehiclePlantParams::legacy();
+    p.integrator = integ;
+    VehiclePlant plant(p);
+    Inputs in{};
+    Outputs out{};
+    out.motor_cmd = 0.5;
+    for (int tick = 0; tick < 100; ++tick) plant.step(out, in, DT_S);
+    const double exact = (0.5 * 2.0 / 1.2) * (1.0 - std::exp(-1.2 * 1.0));
+    return std::abs(plant.vel - exact);
+  };
+  const double err_rk4 = first_order_err(PlantIntegrator::RK4);
+  const double err_euler = first_order_err(PlantIntegrator::Euler);
+  const bool rk4_ok = err_rk4 < 1e-9 && err_euler > 1e3 * err_rk4;
+
+  // 3) 경사: 정지 마찰보다 약하면 그대로, 강하면 뒤로 밀림
+  auto roll_after_2s = [](double slope) {
+    VehiclePlantParams p;
+    p.slope_rad = slope;
+    VehiclePlant plant(p);
+    Inputs in{};
+    const Outputs out{};
+    for (int tick = 0; tick < 200; ++tick) plant.step(out, in, DT_S);
+    return plant.vel;
+  };
+  const bool slope_ok = roll_after_2s(0.01) == 0.0 && roll_after_2s(0.03) < -0.1;
+
+  // 4) lift: cmd 유지 -> 약 4s에 complete, cmd 해제 -> 0으로 복귀
+  int complete_tick = -1;
+  double lowered = 1.0;
+  {
+    VehiclePlant plant;
+    Inputs in{};
+    Outputs out{};
+    out.lift_cmd = true;
+    for (int tick = 0; tick < 600; ++tick) {
+      plant.step(out, in, DT_S);
+      if (complete_tick < 0 && in.lift_complete) complete_tick = tick;
+    }
+    out.lift_cmd = false;
+    for (int tick = 0; tick < 600; ++tick) plant.step(out, in, DT_S);
+    lowered = plant.lift_pos;
+  }
+  const bool lift_ok = complete_tick >= 380 && complete_tick <= 450 && lowered == 0.0;
+
+  // 5) closed loop: 기존 gain으로 VehiclePlant step 응답 (참고용 출력)
+  ControllerCore core;
+  VehiclePlant vp;
+  const StepResult r = run_drive_case(DriveStep_0_1{}, core, vp);
+
+  os << "Legacy == Plant    : " << (legacy_ok ? "PASS" : "FAIL") << "\n";
+  os << "RK4 vs exact       : " << (rk4_ok ? "PASS" : "FAIL") << " (rk4 " << err_rk4 << ", euler " << err_euler << ")\n";
+  os << "Slope/stiction     : " << (slope_ok ? "PASS" : "FAIL") << "\n";
+  os << "Lift hydraulics    : " << (lift_ok ? "PASS" : "FAIL") << " (complete at t=" << complete_tick * DT_S << "s)\n";
+  os << "Step 0->1 (info)   : rise " << r.m.rise_time << " s, overshoot " << r.m.overshoot_pct
+     << " %, ss_err " << r.m.ss_error << "\n";
+  const bool all = legacy_ok && rk4_ok && slope_ok && lift_ok;
+  os << "RESULT: " << (all ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return all;
+}
+SCENARIO_CASE("plant", "vehicle_model", run_vehicle_plant_case);
+
+// =======================
+// Timeline(.tl): 파일 시나리오를 ScenarioInputSource로 재생
+// - step 있으면 drive metrics 판정, expect는 해당 tick step 직후 값 검사
+// - --timelines DIR의 *.tl 파일마다 "timeline/<파일명>" case로 등록 (rebuild 없이 추가)
+// =======================
+static std::string g_timeline_dir = ScenarioRunOptions{}.timeline_dir;
+
+static bool run_timeline_case(const TimelineScenario& sc, std::ostream& os) {
+  ControllerCore core;
+  Plant plant;
+  ScenarioInputSource<TimelineScenario> src(sc, DT_S);
+  StepMetricsAccumulator acc(sc.step_tick() * DT_S, sc.end_tick() * DT_S, sc.v0(), sc.v1());
+
+  const auto& expects = sc.expects();
+  std::size_t next = 0;
+  bool expects_ok = true;
+  std::ostringstream expect_log;
+
+  InputFrame f;
+  while (src.read(f)) {
+    const int tick = src.tick() - 1;
+    Inputs& in = f.in;
+    in.velocity = plant.vel;   // source frame엔 feedback이 없으니 plant 값으로
+    const Outputs out = core.step(in, DT_S);
+    plant.step(out, in, DT_S);
+    if (sc.has_step()) acc.add(Sample{tick * DT_S, in.target_velocity, in.velocity, out.motor_cmd});
+
+    for (; next < expects.size() && expects[next].tick == tick; ++next) {
+      const TimelineExpect& x = expects[next];
+      const double got = timeline_probe(x.probe, out, core.debug(), in);
+      const bool ok = std::abs(got - x.value) <= x.tol;
+      expects_ok = expects_ok && ok;
+      expect_log << "expect t=" << tick << " " << TIMELINE_PROBES[static_cast<int>(x.probe)] << "=" << x.value
+                 << " : " << (ok ? "PASS" : "FAIL") << " (got " << got << ")\n";
+    }
+  }
+
+  bool pass = expects_ok;
+  if (sc.has_step()) {
+    const Metrics m = acc.result();
+    const StepResult r{sc.name(), m, judge(m, DriveCriteria{})};
+    print_step_report(r, os);
+    pass = pass && step_passed(r.pf);
+  } else {
+    os << "\n[" << sc.name() << "]\n";
+  }
+  os << expect_log.str();
+  if (!sc.has_step() || !expects.empty())
+    os << "RESULT: " << (pass ? "✅ PASS" : "❌ FAIL") << "\n";
+  os << "\n";
+  return pass;
+}
+
+static void register_timeline_cases(const ScenarioRunOptions& opt) {
+  g_timeline_dir = opt.timeline_dir;
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  std::vector<fs::path> files;
+  for (fs::directory_iterator it(opt.timeline_dir, ec), end; !ec && it != end; it.increment(ec))
+    if (it->path().extension() == ".tl") files.push_back(it->path());
+  std::sort(files.begin(), files.end());
+
+  auto& reg = ScenarioRegistry::instance();
+  if (files.empty()) {
+    const std::string dir = opt.timeline_dir;
+    reg.add("timeline", "load", [dir](std::ostream& os) {
+      os << "\n[TIMELINE]\nno .tl files in " << dir << " (--timelines DIR)\nRESULT: ❌ FAIL\n\n";
+      return false;
+    });
+    return;
+  }
+  for (const auto& p : files) {
+    // load는 여기서 1번 (parse 실패도 case로 남겨서 FAIL 처리)
+    auto sc = std::make_shared<TimelineScenario>();
+    std::string err;
+    const bool loaded = sc->load(p.string(), err);
+    reg.add("timeline", p.stem().string(), [sc, loaded, err](std::ostream& os) {
+      if (!loaded) {
+        os << "\n[TIMELINE]\n" << err << "\nRESULT: ❌ FAIL\n\n";
+        return false;
+      }
+      return run_timeline_case(*sc, os);
+    });
+  }
+}
+
+// compiled 시나리오와 .tl 재생이 tick마다 bit 단위로 같은지 (입력/출력/debug/plant)
+template <typename CompiledScenario>
+static bool timeline_matches(const CompiledScenario& ref, const std::string& file, std::ostream& os) {
+  TimelineScenario tl;
+  std::string err;
+  if (!tl.load(g_timeline_dir + "/" + file, err)) {
+    os << err << "\n";
+    return false;
+  }
+  if (tl.end_tick() != ref.end_tick() || std::strcmp(tl.name(), ref.name()) != 0) return false;
+
+  ControllerCore core_a, core_b;
+  Plant plant_a, plant_b;
+  Inputs a{};
+  ref.init(a);
+  ScenarioInputSource<TimelineScenario> src(tl, DT_S);
+  InputFrame f;
+  for (int tick = 0; tick < ref.end_tick(); ++tick) {
+    ref.apply(tick, a);
+    if (!src.read(f)) return false;
+    Inputs& b = f.in;
+    b.velocity = plant_b.vel;
+    const Outputs out_a = core_a.step(a, DT_S);
+    const Outputs out_b = core_b.step(b, DT_S);
+    plant_a.step(out_a, a, DT_S);
+    plant_b.step(out_b, b, DT_S);
+    if (!same_output(out_a, out_b) || !same_debug(core_a.debug(), core_b.debug()) ||
+        !same_bits(a.velocity, b.velocity) || a.operator_ack != b.operator_ack ||
+        a.estop_button != b.estop_button || a.comms_ok != b.comms_ok) {
+      os << file << ": diverged at tick " << tick << "\n";
+      return false;
+    }
+  }
+  return !src.read(f);
+}
+
+static bool run_timeline_equivalence_case(std::ostream& os) {
+  os << "\n[TIMELINE == COMPILED]\n";
+  const bool step_0_1 = timeline_matches(DriveStep_0_1{}, "drive_step_0_1.tl", os);
+  const bool step_1_03 = timeline_matches(DriveStep_1_03{}, "drive_step_1_03.tl", os);
+  const bool estop = timeline_matches(FaultEstop{}, "fault_estop.tl", os);
+  const bool comms = timeline_matches(CommsLostLatch{}, "comms_lost_latch.tl", os);
+
+  // 잘못된 파일: 줄 번호 포함 error
+  TimelineScenario bad;
+  std::string err;
+  std::istringstream text("end 100\n50 estop_button 1\n60 warp_drive 1\n");
+  const bool reject_ok = !bad.parse(text, "bad.tl", err) && err.rfind("bad.tl:3:", 0) == 0;
+
+  os << "drive_step_0_1     : " << (step_0_1 ? "PASS" : "FAIL") << "\n";
+  os << "drive_step_1_03    : " << (step_1_03 ? "PASS" : "FAIL") << "\n";
+  os << "fault_estop        : " << (estop ? "PASS" : "FAIL") << "\n";
+  os << "comms_lost_latch   : " << (comms ? "PASS" : "FAIL") << "\n";
+  os << "Reject bad file    : " << (reject_ok ? "PASS" : "FAIL") << " (" << err << ")\n";
+  const bool all = step_0_1 && step_1_03 && estop && comms && reject_ok;
+  os << "RESULT: " << (all ? "✅ PASS" : "❌ FAIL") << "\n\n";
+  return all;
+}
+SCENARIO_CASE("timeline", "compiled_equivalence", run_timeline_equivalence_case);
+
+// =======================
+// main: 등록된 case를 병렬 실행 (--shard / --filter / --junit / --json, scenario_runner.hpp)
+// .tl 파일 case는 인자 파싱 뒤 runtime 등록
+// =======================
+int main(int argc, char** argv) { return scenario_main(argc, argv, register_timeline_cases); }
@@ -0,0 +1,49 @@
+#pragma once
+#include "../src/controller_core.hpp"
+#include "../sim/plant.hpp"
+#include "../sim/vehicle_plant.hpp"
+#include "metrics/drive_metrics.hpp"
+
+// test_runner / gain_sweep 공용
+static constexpr double DT_S = 0.01;
+
+// =======================
+// Drive scenario runner
+// PlantT: Plant / VehiclePlant (step(out, in, dt)만 있으면 됨)
+// =======================
+template <typename DriveScenario, typename PlantT>
+inline StepResult run_drive_case(const DriveScenario& sc,
+                                 ControllerCore& core,
+                                 PlantT& plant) {
+  Inputs in{};
+  Outputs out{};
+
+  sc.init(in);
+
+  const double step_time = sc.step_tick() * DT_S;
+  const double end_time  = sc.end_tick()  * DT_S;
+
+  // 로그를 쌓지 않고 tick마다 바로 누적
+  StepMetricsAccumulator acc(step_time, end_time, sc.v0(), sc.v1());
+
+  for (int tick = 0; tick < sc.end_tick(); ++tick) {
+    sc.apply(tick, in);          // command 생성
+    out = core.step(in, DT_S);   // 제어기
+    plant.step(out, in, DT_S);   // plant + sensor
+
+    const double t = tick * DT_S;
+    acc.add(Sample{
+      t,
+      in.target_velocity,
+      in.velocity,
+      out.motor_cmd
+    });
+  }
+
+  Metrics m = acc.result();
+
+  DriveCriteria crit;
+  PassFail pf = judge(m, crit);
+
+  return StepResult{sc.name(), m, pf};
+}
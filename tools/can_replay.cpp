@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../runtime/can_replay.hpp"
+
+// =====================
+// CAN capture replay 회귀
+//   can_replay drive.cap              CPU 속도로 재생, 0x200을 기록과 bit 비교
+//   can_replay drive.cap --realtime   기록 간격대로 재생
+// 종료 코드: 0 = 전 tick 일치, 1 = mismatch / 읽기 실패
+// =====================
+
+static void usage() {
+    std::cerr << "usage: can_replay <capture.cap> [--realtime]\n";
+}
+
+static void print_frame(const char* tag, const CanFrame& f) {
+    std::cout << "  " << tag << " id=0x" << std::hex << f.id << " data=";
+    for (int i = 0; i < f.dlc && i < 8; ++i)
+        std::cout << std::setw(2) << std::setfill('0') << static_cast<int>(f.data[i]);
+    std::cout << std::dec << std::setfill(' ') << "\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3 || (argc == 3 && std::strcmp(argv[2], "--realtime") != 0)) {
+        usage();
+        return 2;
+    }
+    const bool realtime = argc == 3;
+
+    CanCaptureReader cap(argv[1]);
+    if (!cap.is_open()) {
+        std::cerr << cap.error() << "\n";
+        return 1;
+    }
+
+    SteadyClock wall;
+    CanReplayInputSource src(cap, realtime ? &wall : nullptr);
+    ControllerCore core;
+    Plant plant;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const CanReplayResult r = replay_can_capture(src, core, plant);
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "frames=" << cap.records().size() << " ticks=" << r.ticks
+              << " mismatches=" << r.mismatches
+              << " wall=" << s << " s"
+              << " speedup=" << (s > 0.0 ? r.ticks * 0.01 / s : 0.0) << "x\n";
+    if (r.mismatches) {
+        std::cout << "first mismatch at tick " << r.first_mismatch_tick << "\n";
+        print_frame("expected", r.first_expected);
+        print_frame("got     ", r.first_got);
+    }
+    std::cout << "RESULT: " << (r.ok() ? "✅ PASS" : "❌ FAIL") << "\n";
+    return r.ok() ? 0 : 1;
+}
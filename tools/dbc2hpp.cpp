@@ -0,0 +1,292 @@
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// =====================
+// DBC -> header-only codec 생성기 (빌드 시 실행, 10ms 루프에는 파싱 없음)
+//   dbc2hpp <in.dbc> <out.hpp> [namespace]
+//
+// - BO_/SG_ -> CanMessage/Signal (can_signal.hpp) layout
+// - BA_ "CodecStruct" BO_ <id> "Inputs"|"Outputs" 가 붙은 메시지는
+//   signal 이름 == struct field 이름으로 encode/decode/copy_fields 함수 생성
+// - 지원 안 함: multiplexed signal, CAN FD (dlc > 8), 지수 표기 scale
+// =====================
+
+struct DbcSignal {
+    std::string name;
+    unsigned start = 0;
+    unsigned len = 0;
+    bool motorola = false;
+    bool is_signed = false;
+    std::string scale_num = "1", scale_den = "1";
+    std::string offset_num = "0", offset_den = "1";
+    double min = 0.0, max = 0.0;
+    std::string unit;
+};
+
+struct DbcMessage {
+    std::uint32_t id = 0;
+    bool extended = false;
+    std::string name;
+    unsigned dlc = 0;
+    std::string sender;
+    std::string comment;
+    std::string codec_struct;   // "Inputs" / "Outputs" / ""
+    std::vector<DbcSignal> signals;
+};
+
+static int g_line = 0;
+
+[[noreturn]] static void fail(const std::string& msg) {
+    std::cerr << "dbc2hpp: line " << g_line << ": " << msg << "\n";
+    std::exit(1);
+}
+
+static bool is_ident(const std::string& s) {
+    if (s.empty() || !(std::isalpha(static_cast<unsigned char>(s[0])) || s[0] == '_')) return false;
+    for (char c : s)
+        if (!(std::isalnum(static_cast<unsigned char>(c)) || c == '_')) return false;
+    return true;
+}
+
+// "0.001" -> ("1", "1000"), "-2.5" -> ("-25", "10") : std::ratio가 약분
+static void decimal_to_ratio(const std::string& s, std::string& num, std::string& den) {
+    std::string digits;
+    std::size_t frac = 0;
+    bool dot = false;
+    std::size_t i = 0;
+    bool neg = false;
+    if (i < s.size() && (s[i] == '-' || s[i] == '+')) neg = (s[i++] == '-');
+    for (; i < s.size(); ++i) {
+        if (s[i] == '.' && !dot) { dot = true; continue; }
+        if (!std::isdigit(static_cast<unsigned char>(s[i]))) fail("unsupported number '" + s + "'");
+        digits += s[i];
+        if (dot) ++frac;
+    }
+    if (digits.empty()) fail("empty number");
+    if (frac > 18) fail("too many decimals in '" + s + "'");
+
+    const auto first = digits.find_first_not_of('0');
+    digits = (first == std::string::npos) ? "0" : digits.substr(first);
+    if (digits.size() > 18) fail("number too large for std::ratio: '" + s + "'");
+
+    num = (neg && digits != "0" ? "-" : "") + digits;
+    den = "1" + std::string(frac, '0');
+}
+
+// SG_ name : start|len@order sign (scale,offset) [min|max] "unit" receivers
+static DbcSignal parse_signal(const std::string& line) {
+    DbcSignal s;
+    std::istringstream is(line);
+    std::string tag, colon;
+    is >> tag >> s.name >> colon;
+    if (colon != ":") fail("multiplexed signal '" + s.name + "' is not supported");
+    if (!is_ident(s.name)) fail("bad signal name '" + s.name + "'");
+
+    std::string layout;
+    is >> layout;
+    unsigned start = 0, len = 0;
+    char order = 0, sign = 0;
+    if (std::sscanf(layout.c_str(), "%u|%u@%c%c", &start, &len, &order, &sign) != 4)
+        fail("bad signal layout '" + layout + "'");
+    if (order != '0' && order != '1') fail("bad byte order in '" + layout + "'");
+    if (sign != '+' && sign != '-') fail("bad sign in '" + layout + "'");
+    if (len < 1 || len > 64 || start > 63) fail("signal '" + s.name + "' out of 64 bit payload");
+    s.start = start;
+    s.len = len;
+    s.motorola = (order == '0');
+    s.is_signed = (sign == '-');
+
+    const auto lp = line.find('(');
+    const auto cm = line.find(',', lp);
+    const auto rp = line.find(')', cm);
+    if (lp == std::string::npos || cm == std::string::npos || rp == std::string::npos)
+        fail("missing (scale,offset) for '" + s.name + "'");
+    decimal_to_ratio(line.substr(lp + 1, cm - lp - 1), s.scale_num, s.scale_den);
+    decimal_to_ratio(line.substr(cm + 1, rp - cm - 1), s.offset_num, s.offset_den);
+    if (s.scale_num == "0") fail("zero scale for '" + s.name + "'");
+
+    const auto lb = line.find('[', rp);
+    const auto bar = line.find('|', lb);
+    const auto rb = line.find(']', bar);
+    if (lb != std::string::npos && bar != std::string::npos && rb != std::string::npos) {
+        s.min = std::atof(line.substr(lb + 1, bar - lb - 1).c_str());
+        s.max = std::atof(line.substr(bar + 1, rb - bar - 1).c_str());
+    }
+    const auto q0 = line.find('"', rb == std::string::npos ? rp : rb);
+    const auto q1 = (q0 == std::string::npos) ? q0 : line.find('"', q0 + 1);
+    if (q1 != std::string::npos) s.unit = line.substr(q0 + 1, q1 - q0 - 1);
+    return s;
+}
+
+static std::string quoted(const std::string& line, std::size_t from = 0) {
+    const auto q0 = line.find('"', from);
+    const auto q1 = (q0 == std::string::npos) ? q0 : line.find('"', q0 + 1);
+    return (q1 == std::string::npos) ? std::string() : line.substr(q0 + 1, q1 - q0 - 1);
+}
+
+static std::vector<DbcMessage> parse_dbc(std::istream& in) {
+    std::vector<DbcMessage> msgs;
+    std::map<std::uint64_t, std::size_t> by_raw_id;   // DBC id (extended bit 포함) -> index
+    DbcMessage* cur = nullptr;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        ++g_line;
+        const auto b = line.find_first_not_of(" \t\r");
+        if (b == std::string::npos) { cur = nullptr; continue; }
+        const std::string t = line.substr(b);
+
+        if (t.rfind("BO_ ", 0) == 0) {
+            DbcMessage m;
+            std::istringstream is(t);
+            std::string tag, name;
+            std::uint64_t raw_id = 0;
+            is >> tag >> raw_id >> name >> m.dlc >> m.sender;
+            if (name.empty() || name.back() != ':') fail("bad BO_ line");
+            name.pop_back();
+            if (!is_ident(name)) fail("bad message name '" + name + "'");
+            if (m.dlc > 8) fail("message '" + name + "': dlc > 8 (CAN FD) is not supported");
+            m.name = name;
+            m.extended = (raw_id & 0x80000000ull) != 0;
+            m.id = static_cast<std::uint32_t>(raw_id & 0x1FFFFFFFull);
+            if (by_raw_id.count(raw_id)) fail("duplicate message id " + std::to_string(raw_id));
+            by_raw_id[raw_id] = msgs.size();
+            msgs.push_back(m);
+            cur = &msgs.back();
+        } else if (t.rfind("SG_ ", 0) == 0) {
+            if (!cur) fail("SG_ outside of BO_");
+            cur->signals.push_back(parse_signal(t));
+        } else if (t.rfind("CM_ BO_ ", 0) == 0) {
+            std::istringstream is(t.substr(8));
+            std::uint64_t raw_id = 0;
+            is >> raw_id;
+            const auto it = by_raw_id.find(raw_id);
+            if (it != by_raw_id.end()) msgs[it->second].comment = quoted(t);
+        } else if (t.rfind("BA_ \"CodecStruct\" BO_ ", 0) == 0) {
+            std::istringstream is(t.substr(22));
+            std::uint64_t raw_id = 0;
+            is >> raw_id;
+            const auto it = by_raw_id.find(raw_id);
+            if (it == by_raw_id.end()) fail("CodecStruct for unknown message " + std::to_string(raw_id));
+            const std::string st = quoted(t, 22);
+            if (st != "Inputs" && st != "Outputs" && !st.empty()) fail("CodecStruct must be Inputs or Outputs");
+            msgs[it->second].codec_struct = st;
+        } else {
+            cur = nullptr;
+        }
+    }
+    return msgs;
+}
+
+static std::string hex(std::uint32_t v) {
+    std::ostringstream os;
+    os << "0x" << std::hex << std::uppercase << v;
+    return os.str();
+}
+
+static std::string signal_type(const DbcSignal& s) {
+    std::ostringstream os;
+    os << "Signal<" << s.start << ", " << s.len << ", " << (s.is_signed ? "true" : "false")
+       << ", std::ratio<" << s.scale_num << ", " << s.scale_den << ">"
+       << ", std::ratio<" << s.offset_num << ", " << s.offset_den << ">"
+       << ", ByteOrder::" << (s.motorola ? "Motorola" : "Intel") << ">";
+    return os.str();
+}
+
+static void emit(std::ostream& os, const std::vector<DbcMessage>& msgs,
+                 const std::string& src, const std::string& ns) {
+    os << "#pragma once\n"
+       << "// generated by dbc2hpp from " << src << " -- do not edit\n"
+       << "#include \"drivers/can_signal.hpp\"\n"
+       << "#include \"main_inputs_outputs.hpp\"\n\n"
+       << "namespace " << ns << " {\n";
+
+    for (const auto& m : msgs) {
+        os << "\n// " << m.name << " (" << hex(m.id) << (m.extended ? ", extended" : "")
+           << ", dlc " << m.dlc << ", from " << m.sender << ")";
+        if (!m.comment.empty()) os << ": " << m.comment;
+        os << "\n";
+        os << "struct " << m.name << " : CanMessage<" << hex(m.id) << ", " << m.dlc << "> {\n";
+        for (const auto& s : m.signals) {
+            os << "    using " << s.name << " = " << signal_type(s) << ";";
+            if (!s.unit.empty() || s.min != s.max)
+                os << "  // [" << s.min << ", " << s.max << "]" << (s.unit.empty() ? "" : " " + s.unit);
+            os << "\n";
+        }
+        if (!m.signals.empty()) {
+            os << "    static_assert(fits<";
+            for (std::size_t i = 0; i < m.signals.size(); ++i) os << (i ? ", " : "") << m.signals[i].name;
+            os << ">(), \"" << m.name << ": signal exceeds dlc\");\n";
+        }
+
+        if (!m.codec_struct.empty()) {
+            const std::string& S = m.codec_struct;
+            os << "\n    static CanFrame encode(const " << S << "& s) {\n"
+               << "        CanFrame f = make();\n";
+            for (const auto& s : m.signals)
+                os << "        can_store<" << s.name << ">(f.data, s." << s.name << ");\n";
+            os << "        return f;\n    }\n\n"
+               << "    static void decode(const CanFrame& f, " << S << "& s) {\n";
+            for (const auto& s : m.signals)
+                os << "        can_load<" << s.name << ">(s." << s.name << ", f.data);\n";
+            os << "    }\n\n"
+               << "    // 이 메시지가 싣는 field만 from -> to (양자화 없이)\n"
+               << "    static void copy_fields(const " << S << "& from, " << S << "& to) {\n";
+            for (const auto& s : m.signals)
+                os << "        to." << s.name << " = from." << s.name << ";\n";
+            os << "    }\n";
+        }
+        os << "};\n";
+    }
+
+    // id dispatch (struct별)
+    for (const char* S : {"Inputs", "Outputs"}) {
+        os << "\n// frame id에 맞는 메시지로 " << S << " 갱신, 모르는 id면 false\n"
+           << "inline bool decode(const CanFrame& f, " << S << "& s) {\n"
+           << "    switch (f.id) {\n";
+        for (const auto& m : msgs)
+            if (m.codec_struct == S)
+                os << "        case " << m.name << "::id: " << m.name << "::decode(f, s); return true;\n";
+        os << "        default: return false;\n    }\n}\n";
+    }
+
+    os << "\n} // namespace " << ns << "\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "usage: dbc2hpp <in.dbc> <out.hpp> [namespace]\n";
+        return 2;
+    }
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    const std::string ns = (argc == 4) ? argv[3] : "dbc";
+    if (!is_ident(ns)) {
+        std::cerr << "bad namespace '" << ns << "'\n";
+        return 2;
+    }
+
+    const auto msgs = parse_dbc(in);
+
+    std::ostringstream os;
+    emit(os, msgs, argv[1], ns);
+
+    std::ofstream out(argv[2]);
+    if (!(out << os.str())) {
+        std::cerr << "cannot write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "dbc2hpp: " << msgs.size() << " messages -> " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/controller_core.hpp"
+#include "../sim/plant.hpp"
+#include "../sim/vehicle_plant.hpp"
+#include "../include/util/work_stealing_pool.hpp"
+
+#include "test_runner.hpp"
+#include "scenarios/drive_step_0_1.hpp"
+#include "scenarios/drive_step_1_03.hpp"
+#include "scenarios/drive_step_03_08.hpp"
+
+// =====================
+// drive PID (Kp, Ki, Kd) gain sweep / auto-tuner
+// - 후보마다 drive 시나리오 전체를 run_drive_case로 돌리고 judge로 채점
+// - 후보 단위 task를 work-stealing pool에서 병렬 실행
+// - 결과: 전 시나리오 PASS 후보 수 + (worst rise, worst overshoot) Pareto front
+//
+// 사용 예:
+//   gain_sweep --grid 1.0:3.0:21 0.5:4.0:21 0.0:0.2:5
+//   gain_sweep --random 100000 --seed 7 --threads 32 --csv sweep.csv
+//   gain_sweep --plant vehicle ...   VehiclePlant (모터 지연/마찰/RK4) 기본 파라미터로 채점
+// =====================
+
+struct Range {
+    double lo = 0.0;
+    double hi = 0.0;
+    int n = 1;
+
+    double at(int i) const { return (n <= 1) ? lo : lo + (hi - lo) * i / (n - 1); }
+};
+
+struct Candidate {
+    double kp = 0.0, ki = 0.0, kd = 0.0;
+
+    bool all_pass = false;
+    double worst_rise = NAN;       // s, 시나리오 중 최댓값 (미도달이면 NaN)
+    double worst_over = 0.0;       // %
+    double worst_settle = NAN;     // s
+};
+
+struct SweepConfig {
+    Range kp{1.0, 3.0, 21};
+    Range ki{0.5, 4.0, 21};
+    Range kd{0.0, 0.2, 5};
+
+    std::size_t random_count = 0;  // >0 이면 random search
+    unsigned seed = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string csv_path;
+    bool vehicle_plant = false;    // false: Plant (기존 1차 모델)
+};
+
+static bool parse_range(const char* s, Range& r) {
+    return std::sscanf(s, "%lf:%lf:%d", &r.lo, &r.hi, &r.n) == 3 && r.n >= 1;
+}
+
+static void usage() {
+    std::cerr
+        << "usage: gain_sweep [--grid KP0:KP1:N KI0:KI1:N KD0:KD1:N]\n"
+        << "                  [--random COUNT] [--seed S] [--threads T] [--csv PATH]\n"
+        << "                  [--plant legacy|vehicle]\n"
+        << "  --grid   : 격자 탐색 (random이 없을 때 기본값 1.0:3.0:21 0.5:4.0:21 0.0:0.2:5)\n"
+        << "  --random : grid 범위(lo~hi) 안에서 COUNT개 균등 랜덤 후보\n";
+}
+
+static bool parse_args(int argc, char** argv, SweepConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--grid" && i + 3 < argc) {
+            if (!parse_range(argv[i + 1], cfg.kp) || !parse_range(argv[i + 2], cfg.ki) ||
+                !parse_range(argv[i + 3], cfg.kd)) return false;
+            i += 3;
+        } else if (a == "--random" && i + 1 < argc) {
+            cfg.random_count = std::strtoull(argv[++i], nullptr, 10);
+        } else if (a == "--seed" && i + 1 < argc) {
+            cfg.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--threads" && i + 1 < argc) {
+            cfg.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--csv" && i + 1 < argc) {
+            cfg.csv_path = argv[++i];
+        } else if (a == "--plant" && i + 1 < argc) {
+            const std::string p = argv[++i];
+            if (p != "legacy" && p != "vehicle") return false;
+            cfg.vehicle_plant = p == "vehicle";
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::vector<Candidate> make_candidates(const SweepConfig& cfg) {
+    std::vector<Candidate> c;
+
+    if (cfg.random_count > 0) {
+        std::mt19937 rng(cfg.seed);
+        std::uniform_real_distribution<double> up(cfg.kp.lo, cfg.kp.hi);
+        std::uniform_real_distribution<double> ui(cfg.ki.lo, cfg.ki.hi);
+        std::uniform_real_distribution<double> ud(cfg.kd.lo, cfg.kd.hi);
+        c.resize(cfg.random_count);
+        for (auto& x : c) { x.kp = up(rng); x.ki = ui(rng); x.kd = ud(rng); }
+        return c;
+    }
+
+    c.reserve(static_cast<std::size_t>(cfg.kp.n) * cfg.ki.n * cfg.kd.n);
+    for (int a = 0; a < cfg.kp.n; ++a)
+        for (int b = 0; b < cfg.ki.n; ++b)
+            for (int d = 0; d < cfg.kd.n; ++d) {
+                Candidate x;
+                x.kp = cfg.kp.at(a); x.ki = cfg.ki.at(b); x.kd = cfg.kd.at(d);
+                c.push_back(x);
+            }
+    return c;
+}
+
+template <typename DriveScenario>
+static StepResult run_scenario(const DriveScenario& sc, const Candidate& c, bool vehicle_plant) {
+    ControllerCore core;
+    core.set_drive_gains(c.kp, c.ki, c.kd);
+    if (vehicle_plant) {
+        VehiclePlant plant;
+        return run_drive_case(sc, core, plant);
+    }
+    Plant plant;
+    return run_drive_case(sc, core, plant);
+}
+
+// 시나리오 중 최악값, 하나라도 미도달(NaN)이면 NaN
+static double worst_of(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) return NAN;
+    return std::max(a, b);
+}
+
+static void score(Candidate& c, bool vehicle_plant) {
+    const StepResult r[] = {
+        run_scenario(DriveStep_0_1{}, c, vehicle_plant),
+        run_scenario(DriveStep_1_03{}, c, vehicle_plant),
+        run_scenario(DriveStep_03_08{}, c, vehicle_plant),
+    };
+
+    c.all_pass = true;
+    c.worst_rise = r[0].m.rise_time;
+    c.worst_settle = r[0].m.settling_time;
+    c.worst_over = 0.0;
+
+    for (const auto& x : r) {
+        const PassFail& pf = x.pf;
+        c.all_pass = c.all_pass && pf.pr01_rise && pf.pr02_over && pf.pr03_settle && pf.pr04_ss && pf.pr05_sat;
+        c.worst_rise = worst_of(c.worst_rise, x.m.rise_time);
+        c.worst_settle = worst_of(c.worst_settle, x.m.settling_time);
+        c.worst_over = std::max(c.worst_over, x.m.overshoot_pct);
+    }
+}
+
+// rise time / overshoot 둘 다 작을수록 좋음 -> 지배되지 않는 후보만
+static std::vector<Candidate> pareto_front(const std::vector<Candidate>& all) {
+    std::vector<Candidate> c;
+    for (const auto& x : all)
+        if (std::isfinite(x.worst_rise)) c.push_back(x);
+
+    std::sort(c.begin(), c.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.worst_rise != b.worst_rise) return a.worst_rise < b.worst_rise;
+        return a.worst_over < b.worst_over;
+    });
+
+    std::vector<Candidate> front;
+    double best_over = INFINITY;
+    for (const auto& x : c) {
+        if (x.worst_over < best_over) {
+            front.push_back(x);
+            best_over = x.worst_over;
+        }
+    }
+    return front;
+}
+
+static void write_csv(const std::string& path, const std::vector<Candidate>& all) {
+    std::ofstream f(path);
+    f << "kp,ki,kd,all_pass,worst_rise_s,worst_overshoot_pct,worst_settling_s\n";
+    for (const auto& c : all) {
+        f << c.kp << "," << c.ki << "," << c.kd << "," << (c.all_pass ? 1 : 0) << ","
+          << c.worst_rise << "," << c.worst_over << "," << c.worst_settle << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    SweepConfig cfg;
+    if (!parse_args(argc, argv, cfg)) { usage(); return 2; }
+
+    std::vector<Candidate> cands = make_candidates(cfg);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(cfg.threads);
+        // 후보 하나 = 시나리오 3개 x 400 tick, chunk로 task 수 제한
+        const std::size_t chunk = std::max<std::size_t>(1, cands.size() / (pool.size() * 64));
+        pool.parallel_for(cands.size(), chunk, [&](std::size_t i) { score(cands[i], cfg.vehicle_plant); });
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::size_t n_pass = 0;
+    for (const auto& c : cands) n_pass += c.all_pass ? 1 : 0;
+
+    const std::vector<Candidate> front = pareto_front(cands);
+
+    std::cout << "==============================\n";
+    std::cout << "[GAIN SWEEP] " << (cfg.random_count ? "random" : "grid")
+              << " candidates=" << cands.size()
+              << " threads=" << (cfg.threads ? cfg.threads : 1)
+              << " time=" << elapsed << " s\n";
+    std::cout << "All-PASS candidates : " << n_pass << "\n";
+    std::cout << "------------------------------\n";
+    std::cout << "[PARETO FRONT] worst rise(s) vs worst overshoot(%)\n";
+    for (const auto& c : front) {
+        std::cout << "kp=" << c.kp << " ki=" << c.ki << " kd=" << c.kd
+                  << " | rise=" << c.worst_rise << " over=" << c.worst_over
+                  << " settle=" << c.worst_settle
+                  << " " << (c.all_pass ? "PASS" : "FAIL") << "\n";
+    }
+    std::cout << "==============================\n";
+
+    if (!cfg.csv_path.empty()) write_csv(cfg.csv_path, cands);
+    return 0;
+}
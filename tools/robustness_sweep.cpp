@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/controller_fleet.hpp"
+#include "../sim/plant_batch.hpp"
+#include "../include/util/work_stealing_pool.hpp"
+
+#include "test_runner.hpp"
+#include "scenarios/drive_step_0_1.hpp"
+
+// =====================
+// plant 편차(max_accel / drag) population에 대한 drive step 강건성
+// - 차량 N대 = ControllerFleet(SoA) + PlantBatch(SoA/SIMD), chunk 단위로 thread pool
+// - 각 차량: DriveStep_0_1 입력, StepMetricsAccumulator로 채점 (run_drive_case와 같은 기준)
+//
+// 사용 예:
+//   robustness_sweep --n 100000 --spread 0.3 --seed 1 --threads 8
+//   robustness_sweep --gains 2.0 1.5 0.05
+// =====================
+
+struct SweepOptions {
+    std::size_t n = 100000;
+    double spread = 0.3;          // 파라미터 +-30% 균등
+    unsigned seed = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool custom_gains = false;
+    double kp = 0.0, ki = 0.0, kd = 0.0;
+};
+
+struct LaneResult {
+    double max_accel = 0.0, drag = 0.0;
+    Metrics m;
+    bool pass = false;
+};
+
+static constexpr std::size_t CHUNK = 4096;   // task 1개 = fleet/plant 1벌 (lane 수)
+
+static void usage() {
+    std::cerr << "usage: robustness_sweep [--n N] [--spread FRAC] [--seed S] [--threads T]\n"
+              << "                        [--gains KP KI KD]\n";
+}
+
+static bool parse_args(int argc, char** argv, SweepOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--n" && i + 1 < argc)              opt.n = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--spread" && i + 1 < argc)    opt.spread = std::atof(argv[++i]);
+        else if (a == "--seed" && i + 1 < argc)      opt.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--threads" && i + 1 < argc)   opt.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--gains" && i + 3 < argc) {
+            opt.custom_gains = true;
+            opt.kp = std::atof(argv[++i]);
+            opt.ki = std::atof(argv[++i]);
+            opt.kd = std::atof(argv[++i]);
+        }
+        else return false;
+    }
+    return opt.n > 0 && opt.spread >= 0.0 && opt.spread < 1.0;
+}
+
+// lane [first, first + n) 를 한 fleet/batch로
+static void run_chunk(const SweepOptions& opt, std::vector<LaneResult>& res, std::size_t first, std::size_t n) {
+    const DriveStep_0_1 sc;
+    ControllerFleet fleet(n);
+    PlantBatch plants(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        plants.set_params(k, res[first + k].max_accel, res[first + k].drag);
+        if (opt.custom_gains) fleet.set_drive_gains(k, opt.kp, opt.ki, opt.kd);
+    }
+
+    std::vector<Inputs> in(n);
+    std::vector<Outputs> out(n);
+    std::vector<double> cmd(n);
+    std::vector<StepMetricsAccumulator> acc(
+        n, StepMetricsAccumulator(sc.step_tick() * DT_S, sc.end_tick() * DT_S, sc.v0(), sc.v1()));
+    for (auto& x : in) sc.init(x);
+
+    for (int tick = 0; tick < sc.end_tick(); ++tick) {
+        for (std::size_t k = 0; k < n; ++k) sc.apply(tick, in[k]);
+        fleet.step(in.data(), out.data(), DT_S);
+        for (std::size_t k = 0; k < n; ++k) cmd[k] = out[k].motor_cmd;
+        plants.step(cmd.data(), DT_S);
+
+        const double t = tick * DT_S;
+        for (std::size_t k = 0; k < n; ++k) {
+            in[k].velocity = plants.vel[k];
+            acc[k].add(Sample{t, in[k].target_velocity, in[k].velocity, cmd[k]});
+        }
+    }
+
+    const DriveCriteria crit;
+    for (std::size_t k = 0; k < n; ++k) {
+        LaneResult& r = res[first + k];
+        r.m = acc[k].result();
+        r.pass = step_passed(judge(r.m, crit));
+    }
+}
+
+int main(int argc, char** argv) {
+    SweepOptions opt;
+    if (!parse_args(argc, argv, opt)) { usage(); return 2; }
+
+    const Plant nominal;
+    std::vector<LaneResult> res(opt.n);
+    std::mt19937 rng(opt.seed);
+    std::uniform_real_distribution<double> scale(1.0 - opt.spread, 1.0 + opt.spread);
+    for (auto& r : res) {
+        r.max_accel = nominal.max_accel * scale(rng);
+        r.drag = nominal.drag * scale(rng);
+    }
+
+    const std::size_t chunks = (opt.n + CHUNK - 1) / CHUNK;
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(opt.threads);
+        pool.parallel_for(chunks, 1, [&](std::size_t c) {
+            const std::size_t first = c * CHUNK;
+            run_chunk(opt, res, first, std::min(CHUNK, opt.n - first));
+        });
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // rise: 90% 미도달(NaN) lane은 따로 세고, worst는 도달한 lane 중에서
+    std::size_t n_pass = 0, n_no_rise = 0;
+    const LaneResult* worst_over = &res[0];
+    const LaneResult* worst_rise = nullptr;
+    for (const auto& r : res) {
+        n_pass += r.pass ? 1 : 0;
+        if (r.m.overshoot_pct > worst_over->m.overshoot_pct) worst_over = &r;
+        if (std::isnan(r.m.rise_time)) ++n_no_rise;
+        else if (!worst_rise || r.m.rise_time > worst_rise->m.rise_time) worst_rise = &r;
+    }
+
+    std::cout << "==============================\n";
+    std::cout << "[ROBUSTNESS SWEEP] vehicles=" << opt.n << " spread=+-" << opt.spread * 100.0 << "%"
+              << " threads=" << (opt.threads ? opt.threads : 1) << " time=" << elapsed << " s\n";
+    std::cout << "PASS : " << n_pass << " / " << opt.n
+              << " (" << 100.0 * static_cast<double>(n_pass) / static_cast<double>(opt.n) << " %)\n";
+    std::cout << "------------------------------\n";
+    std::cout << "worst overshoot : " << worst_over->m.overshoot_pct << " % (max_accel=" << worst_over->max_accel
+              << " drag=" << worst_over->drag << ")\n";
+    if (worst_rise)
+        std::cout << "worst rise      : " << worst_rise->m.rise_time << " s (max_accel=" << worst_rise->max_accel
+                  << " drag=" << worst_rise->drag << ")\n";
+    else
+        std::cout << "worst rise      : - (no vehicle reached 90%)\n";
+    std::cout << "never rose 90%  : " << n_no_rise << " / " << opt.n << "\n";
+    std::cout << "==============================\n";
+    return 0;
+}
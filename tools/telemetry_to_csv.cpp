@@ -0,0 +1,44 @@
+#include <cstdint>
+#include <iostream>
+
+#include "../src/telemetry_logger.hpp"
+#include "../src/logger.hpp"
+
+// =====================
+// TelemetryLogger 바이너리 -> CSV (CSVLogger와 같은 컬럼/포맷)
+//   telemetry_to_csv drive_tlm.bin drive_pid_log.csv
+// =====================
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: telemetry_to_csv <in.bin> <out.csv>\n";
+        return 2;
+    }
+
+    TelemetryReader tlm(argv[1]);
+    if (!tlm.is_open()) {
+        std::cerr << tlm.error() << "\n";
+        return 1;
+    }
+
+    CSVLogger csv(argv[2], true);
+
+    const std::uint64_t n = tlm.for_each([&](const TelemetryRecord& r) {
+        const auto b = [&](TelemetryFlag fl) { return r.has(fl) ? 1 : 0; };
+        csv.log(
+            r.tick,
+            tlm.dt_s(),
+            state_name(static_cast<State>(r.state)),
+            b(TLM_DRIVE_EN), b(TLM_LIFT_BTN), b(TLM_DUMP_BTN), b(TLM_ESTOP),
+            b(TLM_COMMS_RAW), b(TLM_COMMS_FILT),
+            b(TLM_FAULT_LATCH), fault_name(static_cast<FaultReason>(r.fault_reason)),
+            static_cast<unsigned>(r.fault_code),
+            b(TLM_DRIVE_CMD), b(TLM_LIFT_CMD), b(TLM_DUMP_CMD),
+            r.target_vel, r.vel, r.motor_cmd,
+            r.integ, r.u_unsat, r.u_sat, b(TLM_WINDUP_BLOCK),
+            r.lift_p, r.dump_p
+        );
+    });
+
+    std::cout << "converted " << n << " records -> " << argv[2] << "\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../src/controller_core.hpp"
+#include "../src/telemetry_logger.hpp"
+#include "../src/trace/columnar_trace.hpp"
+#include "../sim/plant.hpp"
+#include "../tests/metrics/drive_metrics.hpp"
+
+// =====================
+// columnar trace (.ctr) 변환 / 생성 / 분석
+//   trace_metrics convert drive_tlm.bin drive.ctr   TelemetryLogger 바이너리 -> .ctr
+//   trace_metrics simulate SECONDS drive.ctr        core + plant 100Hz step 응답을 바로 기록
+//   trace_metrics analyze drive.ctr [--step S] [--end S] [--v0 V] [--v1 V]
+//     mmap column -> StepMetricsAccumulator (parse 없음), 소요 시간 출력
+// =====================
+
+static constexpr double DT_S = 0.01;
+
+static void usage() {
+    std::cerr
+        << "usage: trace_metrics convert <in.bin> <out.ctr>\n"
+        << "       trace_metrics simulate <seconds> <out.ctr>\n"
+        << "       trace_metrics analyze <in.ctr> [--step S] [--end S] [--v0 V] [--v1 V]\n";
+}
+
+static int convert(const char* in_path, const char* out_path) {
+    TelemetryReader tlm(in_path);
+    if (!tlm.is_open()) {
+        std::cerr << tlm.error() << "\n";
+        return 1;
+    }
+    const std::uint64_t n = tlm.record_count();
+    ColumnarTraceWriter w(out_path, n, tlm.dt_s());
+    if (!w.is_open()) {
+        std::cerr << w.error() << "\n";
+        return 1;
+    }
+    tlm.for_each([&](const TelemetryRecord& r) { w.append(r); });
+    w.close();
+    std::cout << "converted " << n << " records -> " << out_path << "\n";
+    return 0;
+}
+
+// 1s에 target 0 -> 1 step 후 유지 (DriveStep_0_1과 같은 입력)
+static int simulate(double seconds, const char* out_path) {
+    const std::uint64_t n = static_cast<std::uint64_t>(seconds / DT_S);
+    ColumnarTraceWriter w(out_path, n, DT_S);
+    if (!w.is_open()) {
+        std::cerr << w.error() << "\n";
+        return 1;
+    }
+
+    ControllerCore core;
+    Plant plant;
+    Inputs in{};
+    in.comms_ok = true;
+    in.battery_ok = true;
+    in.drive_enable = true;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::uint64_t tick = 0; tick < n; ++tick) {
+        in.target_velocity = tick < 100 ? 0.0 : 1.0;
+        const Outputs out = core.step(in, DT_S);
+        plant.step(out, in, DT_S);
+        w.append(make_telemetry_record(static_cast<int>(tick), in, out, core.debug(), plant.lift_pos, plant.dump_pos));
+    }
+    w.close();
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "simulated " << n << " ticks -> " << out_path << " (" << s << " s)\n";
+    return 0;
+}
+
+static int analyze(int argc, char** argv) {
+    const char* path = argv[0];
+    double step = 1.0, end = -1.0, v0 = 0.0, v1 = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--step" && i + 1 < argc)      step = std::atof(argv[++i]);
+        else if (a == "--end" && i + 1 < argc)  end = std::atof(argv[++i]);
+        else if (a == "--v0" && i + 1 < argc)   v0 = std::atof(argv[++i]);
+        else if (a == "--v1" && i + 1 < argc)   v1 = std::atof(argv[++i]);
+        else { usage(); return 2; }
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    ColumnarTraceReader r(path);
+    if (!r.is_open()) {
+        std::cerr << r.error() << "\n";
+        return 1;
+    }
+    const double* t = r.column<double>(TC_TIME_S);
+    const double* target = r.column<double>(TC_TARGET_VEL);
+    const double* vel = r.column<double>(TC_VEL);
+    const double* u = r.column<double>(TC_MOTOR_CMD);
+    if (!t || !target || !vel || !u) {
+        std::cerr << "missing column (time_s/target_vel/vel/motor_cmd)\n";
+        return 1;
+    }
+    const std::size_t n = static_cast<std::size_t>(r.rows());
+    if (end < 0.0) end = n ? t[n - 1] + r.dt_s() : 0.0;
+
+    const Metrics m = compute_metrics_step(t, target, vel, u, n, step, end, v0, v1);
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const PassFail pf = judge(m, DriveCriteria{});
+    print_step_report(StepResult{path, m, pf});
+    std::cout << "rows=" << n << " (" << n * r.dt_s() / 3600.0 << " h)"
+              << " analyze=" << s * 1e3 << " ms\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && std::strcmp(argv[1], "convert") == 0) return convert(argv[2], argv[3]);
+    if (argc >= 4 && std::strcmp(argv[1], "simulate") == 0) return simulate(std::atof(argv[2]), argv[3]);
+    if (argc >= 3 && std::strcmp(argv[1], "analyze") == 0) return analyze(argc - 2, argv + 2);
+    usage();
+    return 2;
+}